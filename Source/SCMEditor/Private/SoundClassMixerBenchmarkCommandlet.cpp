@@ -0,0 +1,795 @@
+﻿#include "SoundClassMixerBenchmarkCommandlet.h"
+
+#include "SimpleFader.h"
+#include "SimpleFaderBank.h"
+#include "SoundBaseWrapperCache.h"
+#include "SoundClassMixerBlueprintFunctionLibrary.h"
+#include "SoundClassMixerManifest.h"
+#include "SoundClassMixerSettings.h"
+#include "SoundClassMixerSubsystem.h"
+#include "USoundBaseWrapper.h"
+#include "AudioDevice.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/GameInstance.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Sound/SoundClass.h"
+#include "Sound/SoundSubmix.h"
+#include "Sound/SoundWave.h"
+#include "Sound/SoundWaveProcedural.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogSoundClassMixerBenchmarkCommandlet, Log, All);
+
+
+namespace SoundClassMixerBenchmarkPrivate
+{
+	const int32 ClassCounts[] = { 64, 256, 1024, 4096 };
+	const float ActiveFractions[] = { 0.0f, 0.01f, 0.1f, 0.5f, 1.0f };
+
+	constexpr int32 NumGatherRuns = 10;
+	constexpr int32 NumFadeCommands = 100000;
+	constexpr int32 NumNameLookupClasses = 1000;
+	constexpr int32 NumNameLookups = 100000;
+	constexpr int32 NumWrapperPairs = 256;
+	constexpr int32 NumWrapperLookups = 100000;
+	constexpr int32 NumWrapperPlays = 10000;
+	constexpr int32 NumOneShots = 1000;
+	constexpr int32 NumCurveEvaluations = 1 << 22;
+	constexpr int32 CurveBatchSize = 1024;
+
+	const int32 FaderBankCounts[] = { 64, 1024, 10240 };
+	constexpr int32 NumFaderBankFrames = 600;
+
+	/** Long enough that no fade completes while a benchmark runs. */
+	constexpr float FadeDuration = 3600.0f;
+	constexpr float FrameDeltaTime = 1.0f / 60.0f;
+}
+
+
+USoundClassMixerBenchmarkCommandlet::USoundClassMixerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USoundClassMixerBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString OutputFilename = FPaths::ProjectSavedDir() / TEXT("SoundClassMixer") / TEXT("Benchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputFilename);
+
+	int32 NumFrames = 600;
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+
+	// Standalone instance: creates a world and initializes the game instance subsystems.
+	// Rooted since the wrapper benchmarks run the garbage collector.
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	USoundClassMixerSubsystem* Subsystem = GameInstance->GetSubsystem<USoundClassMixerSubsystem>();
+	if (!Subsystem)
+	{
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Error, TEXT("SoundClassMixerSubsystem is not available."));
+		return 1;
+	}
+
+	FApp::SetDeltaTime(SoundClassMixerBenchmarkPrivate::FrameDeltaTime);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	BenchmarkGather(Subsystem);
+	BenchmarkManifest(Subsystem);
+	RemoveSyntheticGatherAssets(Subsystem);
+	BenchmarkRegister(Subsystem);
+	BenchmarkUpdate(Subsystem, FMath::Max(1, NumFrames));
+	BenchmarkFadeCommands(Subsystem);
+	BenchmarkCommandPath(Subsystem);
+	BenchmarkNameLookup(Subsystem);
+#else
+	UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Warning, TEXT("Built without automation tests, the subsystem benchmarks are skipped."));
+#endif
+	BenchmarkWrapperCache();
+	BenchmarkWrapperGarbage();
+	BenchmarkOneShots(Subsystem);
+	BenchmarkCurves();
+	BenchmarkFaderBank();
+
+	GameInstance->Shutdown();
+	GameInstance->RemoveFromRoot();
+
+	const FString JsonFilename = FPaths::ChangeExtension(OutputFilename, TEXT("json"));
+	if (!WriteCsv(OutputFilename) || !WriteJson(JsonFilename))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Display, TEXT("Wrote %d results to %s and %s."), Results.Num(), *OutputFilename, *JsonFilename);
+	return 0;
+}
+
+
+// =====================================================================================================================
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+void USoundClassMixerBenchmarkCommandlet::RegisterSyntheticClasses(USoundClassMixerSubsystem* Subsystem, const int32 Count)
+{
+	for (int32 Index = SyntheticClasses.Num(); Index < Count; ++Index)
+	{
+		USoundClass* SoundClass = NewObject<USoundClass>(GetTransientPackage(), *FString::Printf(TEXT("SC_Benchmark_%d"), Index));
+		SoundClass->ParentClass = Index > 0 ? SyntheticClasses[(Index - 1) / 4] : nullptr;
+		SyntheticClasses.Add(SoundClass);
+	}
+
+	Subsystem->ResetChannelsForTesting();
+	Subsystem->RegisterSoundClassesForTesting(MakeArrayView(SyntheticClasses.GetData(), Count));
+
+	// Leave every fader idle so the next benchmark starts from an empty active set.
+	Subsystem->UpdateAudioClassesForTesting();
+}
+
+void USoundClassMixerBenchmarkCommandlet::AddSyntheticGatherAssets(const int32 Count)
+{
+	for (int32 Index = SyntheticGatherClasses.Num(); Index < Count; ++Index)
+	{
+		const FString PackageName = FString::Printf(TEXT("/Game/SoundClassMixerBenchmark/SC_Gather_%d"), Index);
+		UPackage* Package = CreatePackage(*PackageName);
+		USoundClass* SoundClass = NewObject<USoundClass>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+		SoundClass->ParentClass = Index > 0 ? SyntheticGatherClasses[(Index - 1) / 4] : nullptr;
+		FAssetRegistryModule::AssetCreated(SoundClass);
+		SyntheticGatherClasses.Add(SoundClass);
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::RemoveSyntheticGatherAssets(USoundClassMixerSubsystem* Subsystem)
+{
+	Subsystem->ResetChannelsForTesting();
+
+	for (USoundClass* SoundClass : SyntheticGatherClasses)
+	{
+		FAssetRegistryModule::AssetDeleted(SoundClass);
+		SoundClass->ClearFlags(RF_Public | RF_Standalone);
+		SoundClass->MarkPendingKill();
+	}
+	SyntheticGatherClasses.Reset();
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkGather(USoundClassMixerSubsystem* Subsystem)
+{
+	// Async gathers only start their loads; run synchronously here so the whole gather is timed.
+	USoundClassMixerSettings* Settings = GetMutableDefault<USoundClassMixerSettings>();
+	const bool bAsyncGather = Settings->bAsyncGather;
+	Settings->bAsyncGather = false;
+
+	for (const int32 Count : SoundClassMixerBenchmarkPrivate::ClassCounts)
+	{
+		AddSyntheticGatherAssets(Count);
+
+		// Untimed, so the first row doesn't pay for loading the project's own assets.
+		Subsystem->GatherSoundClassesForTesting();
+		const int32 NumGathered = Subsystem->SoundClassMap.Num() + Subsystem->SoundSubmixMap.Num();
+
+		double TotalSeconds = 0.0;
+		for (int32 Run = 0; Run < SoundClassMixerBenchmarkPrivate::NumGatherRuns; ++Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Subsystem->GatherSoundClassesForTesting();
+			TotalSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		if (NumGathered < Count)
+		{
+			UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Warning, TEXT("Gathered %d assets for %d synthetic SoundClasses; the asset filter excludes /Game/SoundClassMixerBenchmark."), NumGathered, Count);
+		}
+		AddResult(TEXT("GatherSoundClasses"), NumGathered, 0.0f, SoundClassMixerBenchmarkPrivate::NumGatherRuns, TotalSeconds);
+	}
+
+	Settings->bAsyncGather = bAsyncGather;
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkManifest(USoundClassMixerSubsystem* Subsystem)
+{
+	// Async gathers only start their loads; both paths run synchronously here so the whole gather is timed.
+	USoundClassMixerSettings* Settings = GetMutableDefault<USoundClassMixerSettings>();
+	const bool bAsyncGather = Settings->bAsyncGather;
+	Settings->bAsyncGather = false;
+
+	for (const int32 NumSynthetic : SoundClassMixerBenchmarkPrivate::ClassCounts)
+	{
+		AddSyntheticGatherAssets(NumSynthetic);
+
+		// Also loads everything, so neither row pays for the first load.
+		Subsystem->ResetChannelsForTesting();
+		Subsystem->GatherFromAssetRegistryForTesting();
+
+		// What the manifest commandlet writes, taken from what the scan registered.
+		FSoundClassMixerManifest Manifest;
+		Manifest.AssetFilterHash = Settings->GetAssetFilterHash();
+		for (const TPair<USoundClass*, int32>& Pair : Subsystem->SoundClassMap)
+		{
+			FSoundClassMixerManifestEntry& Entry = Manifest.SoundClasses.AddDefaulted_GetRef();
+			Entry.Path = FSoftObjectPath(Pair.Key);
+			Entry.DefaultVolume = Pair.Key->Properties.Volume;
+		}
+		for (const TPair<USoundSubmix*, int32>& Pair : Subsystem->SoundSubmixMap)
+		{
+			FSoundClassMixerManifestEntry& Entry = Manifest.SoundSubmixes.AddDefaulted_GetRef();
+			Entry.Path = FSoftObjectPath(Pair.Key);
+			Entry.DefaultVolume = Pair.Key->OutputVolume;
+		}
+		const int32 Count = Manifest.SoundClasses.Num() + Manifest.SoundSubmixes.Num();
+
+		double RegistrySeconds = 0.0;
+		double ManifestSeconds = 0.0;
+		for (int32 Run = 0; Run < SoundClassMixerBenchmarkPrivate::NumGatherRuns; ++Run)
+		{
+			Subsystem->ResetChannelsForTesting();
+			double StartTime = FPlatformTime::Seconds();
+			Subsystem->GatherFromAssetRegistryForTesting();
+			RegistrySeconds += FPlatformTime::Seconds() - StartTime;
+
+			Subsystem->ResetChannelsForTesting();
+			StartTime = FPlatformTime::Seconds();
+			Subsystem->GatherFromManifestForTesting(Manifest);
+			ManifestSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		AddResult(TEXT("Gather_AssetRegistry"), Count, 0.0f, SoundClassMixerBenchmarkPrivate::NumGatherRuns, RegistrySeconds);
+		AddResult(TEXT("Gather_Manifest"), Count, 0.0f, SoundClassMixerBenchmarkPrivate::NumGatherRuns, ManifestSeconds);
+	}
+
+	Settings->bAsyncGather = bAsyncGather;
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkRegister(USoundClassMixerSubsystem* Subsystem)
+{
+	for (const int32 Count : SoundClassMixerBenchmarkPrivate::ClassCounts)
+	{
+		// Create the objects up front, only registration and the hierarchy rebuild are timed.
+		RegisterSyntheticClasses(Subsystem, Count);
+		Subsystem->ResetChannelsForTesting();
+
+		const double StartTime = FPlatformTime::Seconds();
+		Subsystem->RegisterSoundClassesForTesting(MakeArrayView(SyntheticClasses.GetData(), Count));
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Subsystem->UpdateAudioClassesForTesting();
+
+		AddResult(TEXT("RegisterSoundClasses"), Count, 0.0f, Count, TotalSeconds);
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkUpdate(USoundClassMixerSubsystem* Subsystem, const int32 NumFrames)
+{
+	for (const int32 Count : SoundClassMixerBenchmarkPrivate::ClassCounts)
+	{
+		for (const float ActiveFraction : SoundClassMixerBenchmarkPrivate::ActiveFractions)
+		{
+			RegisterSyntheticClasses(Subsystem, Count);
+
+			TArray<FSoundClassMixerCommand> Commands;
+			const int32 NumActive = FMath::RoundToInt(Count * ActiveFraction);
+			for (int32 Index = 0; Index < NumActive; ++Index)
+			{
+				FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+				Command.Type       = ESoundClassMixerCommandType::StartFade;
+				Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+				Command.Target     = SyntheticClasses[Index];
+				Command.Channel    = Subsystem->GetSoundClassChannel(SyntheticClasses[Index]);
+				Command.Volume     = 0.0f;
+				Command.Duration   = SoundClassMixerBenchmarkPrivate::FadeDuration;
+				Command.Curve      = Audio::EFaderCurve::Linear;
+			}
+			Subsystem->EnqueueCommandsForTesting(Commands);
+			Subsystem->UpdateAudioClassesForTesting();
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Subsystem->UpdateAudioClassesForTesting();
+			}
+			const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+			AddResult(TEXT("UpdateAudioClasses"), Count, ActiveFraction, NumFrames, TotalSeconds);
+		}
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkFadeCommands(USoundClassMixerSubsystem* Subsystem)
+{
+	constexpr int32 Count = 1024;
+	RegisterSyntheticClasses(Subsystem, Count);
+
+	// Applied inline without an audio thread (see BenchmarkCommandPath); batched only to match its sizes.
+	const int32 BatchSize = USoundClassMixerSubsystem::GetCommandQueueCapacityForTesting() / 2;
+
+	double TotalSeconds = 0.0;
+	for (int32 Issued = 0; Issued < SoundClassMixerBenchmarkPrivate::NumFadeCommands; Issued += BatchSize)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			USoundClassMixerBlueprintFunctionLibrary::SoundClassFadeTo(
+				Subsystem->GetWorld(),
+				SyntheticClasses[(Issued + Index) % Count],
+				SoundClassMixerBenchmarkPrivate::FadeDuration, (Index & 1) ? 0.25f : 0.75f,
+				EAudioFaderCurve::Linear
+			);
+		}
+		TotalSeconds += FPlatformTime::Seconds() - StartTime;
+
+		Subsystem->UpdateAudioClassesForTesting();
+	}
+
+	const int32 NumIssued = FMath::DivideAndRoundUp(SoundClassMixerBenchmarkPrivate::NumFadeCommands, BatchSize) * BatchSize;
+	AddResult(TEXT("SoundClassFadeTo_Inline"), Count, 0.0f, NumIssued, TotalSeconds);
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkCommandPath(USoundClassMixerSubsystem* Subsystem)
+{
+	constexpr int32 Count = 1024;
+	RegisterSyntheticClasses(Subsystem, Count);
+
+	// One batch per simulated frame, under the ring capacity so nothing spills into the overflow ring.
+	const int32 BatchSize = USoundClassMixerSubsystem::GetCommandQueueCapacityForTesting() / 2;
+
+	// 1: every command targets its own class. 4: each class gets four fades a frame, three are coalesced away.
+	for (const int32 CommandsPerTarget : { 1, 4 })
+	{
+		const int32 NumTargets = BatchSize / CommandsPerTarget;
+
+		double CoalesceSeconds = 0.0;
+		double SubmitSeconds = 0.0;
+		double DrainSeconds = 0.0;
+		int32 NumIssued = 0;
+
+		for (int32 Issued = 0; Issued < SoundClassMixerBenchmarkPrivate::NumFadeCommands; Issued += BatchSize)
+		{
+			TArray<FSoundClassMixerCommand> Commands;
+			Commands.Reserve(BatchSize);
+			for (int32 Index = 0; Index < BatchSize; ++Index)
+			{
+				USoundClass* SoundClass = SyntheticClasses[(Issued + Index % NumTargets) % Count];
+
+				FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+				Command.Type       = ESoundClassMixerCommandType::StartFade;
+				Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+				Command.Target     = SoundClass;
+				Command.Channel    = Subsystem->GetSoundClassChannel(SoundClass);
+				Command.Volume     = (Index & 1) ? 0.25f : 0.75f;
+				Command.Duration   = SoundClassMixerBenchmarkPrivate::FadeDuration;
+				Command.Curve      = Audio::EFaderCurve::Linear;
+			}
+
+			// The game thread half of EnqueueCommands, which would otherwise apply inline here.
+			double StartTime = FPlatformTime::Seconds();
+			for (const FSoundClassMixerCommand& Command : Commands)
+			{
+				Subsystem->CoalesceCommandForTesting(Command);
+			}
+			CoalesceSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Subsystem->FlushCoalescedCommandsForTesting();
+			SubmitSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Subsystem->DrainCommandsForTesting();
+			DrainSeconds += FPlatformTime::Seconds() - StartTime;
+
+			NumIssued += BatchSize;
+		}
+
+		const float RedundantFraction = 1.0f - 1.0f / CommandsPerTarget;
+		AddResult(TEXT("CommandPath_Coalesce"), NumTargets, RedundantFraction, NumIssued, CoalesceSeconds);
+		AddResult(TEXT("CommandPath_Submit"), NumTargets, RedundantFraction, NumIssued, SubmitSeconds);
+		AddResult(TEXT("CommandPath_Drain"), NumTargets, RedundantFraction, NumIssued, DrainSeconds);
+	}
+
+	Subsystem->UpdateAudioClassesForTesting();
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkNameLookup(USoundClassMixerSubsystem* Subsystem)
+{
+	constexpr int32 Count = SoundClassMixerBenchmarkPrivate::NumNameLookupClasses;
+	constexpr int32 NumLookups = SoundClassMixerBenchmarkPrivate::NumNameLookups;
+	RegisterSyntheticClasses(Subsystem, Count);
+
+	// Names arrive as strings from console commands and mixer scripts.
+	TArray<FString> Names;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Names.Add(SyntheticClasses[Index]->GetName());
+	}
+
+	int32 NumFound = 0;
+
+	// Index: FName resolve plus one hash lookup.
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		NumFound += Subsystem->FindSoundClassByNameForTesting(Names[(Lookup * 389) % Count]) ? 1 : 0;
+	}
+	AddResult(TEXT("FindSoundClassByName_Index"), Count, 0.0f, NumLookups, FPlatformTime::Seconds() - StartTime);
+
+	// The scan the index replaced: one GetName() string per map entry until a match.
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		const FString& Name = Names[(Lookup * 389) % Count];
+		for (const TPair<USoundClass*, int32>& Pair : Subsystem->SoundClassMap)
+		{
+			if (Pair.Key->GetName() == Name)
+			{
+				++NumFound;
+				break;
+			}
+		}
+	}
+	AddResult(TEXT("FindSoundClassByName_LinearScan"), Count, 0.0f, NumLookups, FPlatformTime::Seconds() - StartTime);
+
+	if (NumFound != 2 * NumLookups)
+	{
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Warning, TEXT("Name lookup found %d of %d classes."), NumFound, 2 * NumLookups);
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkWrapperCache()
+{
+	TArray<USoundWave*> Sounds;
+	TArray<USoundSubmix*> Submixes;
+	for (int32 Index = 0; Index < SoundClassMixerBenchmarkPrivate::NumWrapperPairs; ++Index)
+	{
+		Sounds.Add(NewObject<USoundWave>(GetTransientPackage()));
+		Submixes.Add(NewObject<USoundSubmix>(GetTransientPackage()));
+	}
+
+	FSoundBaseWrapperCache& WrapperCache = FSoundBaseWrapperCache::Get();
+	WrapperCache.Empty();
+
+	// Every pair is new: wrapper creation.
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < SoundClassMixerBenchmarkPrivate::NumWrapperPairs; ++Index)
+	{
+		WrapperCache.FindOrAdd(Sounds[Index], Submixes[Index]);
+	}
+	AddResult(TEXT("WrapperCacheMiss"), SoundClassMixerBenchmarkPrivate::NumWrapperPairs, 0.0f, SoundClassMixerBenchmarkPrivate::NumWrapperPairs, FPlatformTime::Seconds() - StartTime);
+
+	// Same pairs again: lookups only, as long as WrapperCacheSize holds them all.
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < SoundClassMixerBenchmarkPrivate::NumWrapperLookups; ++Index)
+	{
+		const int32 PairIndex = Index % SoundClassMixerBenchmarkPrivate::NumWrapperPairs;
+		WrapperCache.FindOrAdd(Sounds[PairIndex], Submixes[PairIndex]);
+	}
+	AddResult(TEXT("WrapperCacheHit"), SoundClassMixerBenchmarkPrivate::NumWrapperPairs, 0.0f, SoundClassMixerBenchmarkPrivate::NumWrapperLookups, FPlatformTime::Seconds() - StartTime);
+
+	WrapperCache.Empty();
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkWrapperGarbage()
+{
+	constexpr int32 NumPairs = SoundClassMixerBenchmarkPrivate::NumWrapperPairs;
+	constexpr int32 NumPlays = SoundClassMixerBenchmarkPrivate::NumWrapperPlays;
+
+	// Rooted so only the wrappers are garbage; the cache itself holds nothing alive.
+	TArray<UObject*> Rooted;
+	TArray<USoundWave*> Sounds;
+	TArray<USoundSubmix*> Submixes;
+	for (int32 Index = 0; Index < NumPairs; ++Index)
+	{
+		Sounds.Add(NewObject<USoundWave>(GetTransientPackage()));
+		Submixes.Add(NewObject<USoundSubmix>(GetTransientPackage()));
+		Rooted.Add(Sounds.Last());
+		Rooted.Add(Submixes.Last());
+	}
+	for (UObject* Object : Rooted)
+	{
+		Object->AddToRoot();
+	}
+
+	FSoundBaseWrapperCache& WrapperCache = FSoundBaseWrapperCache::Get();
+
+	// NumPlays play calls over the pairs, then the GC that collects what they left behind.
+	for (const bool bPooled : { false, true })
+	{
+		WrapperCache.Empty();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		const int32 NumObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Play = 0; Play < NumPlays; ++Play)
+		{
+			const int32 PairIndex = Play % NumPairs;
+			if (bPooled)
+			{
+				WrapperCache.FindOrAdd(Sounds[PairIndex], Submixes[PairIndex]);
+			}
+			else
+			{
+				// What the nodes did before the cache, and still do with WrapperCacheSize 0.
+				USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
+				Wrapper->InheritSoundBase(Sounds[PairIndex]);
+				Wrapper->SoundSubmixOverride = Submixes[PairIndex];
+			}
+		}
+		const double CreateSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const int32 NumObjectsCreated = GUObjectArray.GetObjectArrayNumMinusAvailable() - NumObjectsBefore;
+
+		StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const double CollectSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const TCHAR* Mode = bPooled ? TEXT("Pooled") : TEXT("Unpooled");
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Display, TEXT("WrapperGarbage %s: %d objects created by %d plays."), Mode, NumObjectsCreated, NumPlays);
+
+		AddResult(FString::Printf(TEXT("WrapperGarbage_%s_Plays"), Mode), NumPairs, 0.0f, NumPlays, CreateSeconds);
+		AddResult(FString::Printf(TEXT("WrapperGarbage_%s_Collect"), Mode), NumPairs, 0.0f, FMath::Max(1, NumObjectsCreated), CollectSeconds);
+	}
+
+	WrapperCache.Empty();
+	for (UObject* Object : Rooted)
+	{
+		Object->RemoveFromRoot();
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkOneShots(USoundClassMixerSubsystem* Subsystem)
+{
+	UWorld* World = Subsystem->GetWorld();
+	FAudioDevice* AudioDevice = World ? World->GetAudioDeviceRaw() : nullptr;
+	if (!AudioDevice)
+	{
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Warning, TEXT("No audio device (-nosound?), skipping the one-shot benchmark."));
+		return;
+	}
+
+	constexpr int32 NumOneShots = SoundClassMixerBenchmarkPrivate::NumOneShots;
+
+	// Procedural so it's playable without wave data.
+	USoundWaveProcedural* Sound = NewObject<USoundWaveProcedural>(GetTransientPackage());
+	Sound->NumChannels = 1;
+	Sound->SetSampleRate(48000);
+	Sound->Duration = INDEFINITELY_LOOPING_DURATION;
+	USoundSubmix* Submix = NewObject<USoundSubmix>(GetTransientPackage());
+
+	USoundClassMixerSettings* Settings = GetMutableDefault<USoundClassMixerSettings>();
+	const ESoundClassMixerSubmixOverrideMode PreviousMode = Settings->SubmixOverrideMode;
+
+	for (const ESoundClassMixerSubmixOverrideMode Mode : { ESoundClassMixerSubmixOverrideMode::Wrapper, ESoundClassMixerSubmixOverrideMode::SubmixSend })
+	{
+		Settings->SubmixOverrideMode = Mode;
+		FSoundBaseWrapperCache::Get().Empty();
+
+		const int32 NumObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumOneShots; ++Index)
+		{
+			USoundClassMixerBlueprintFunctionLibrary::PlaySound2D_WithSubmixOverride(World, Sound, 1.0f, 1.0f, 0.0f, nullptr, nullptr, false, Submix);
+		}
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const int32 NumObjectsCreated = GUObjectArray.GetObjectArrayNumMinusAvailable() - NumObjectsBefore;
+
+		const TCHAR* ModeName = Mode == ESoundClassMixerSubmixOverrideMode::Wrapper ? TEXT("Wrapper") : TEXT("SubmixSend");
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Display, TEXT("PlaySound2D %s: %d objects created by %d one-shots."), ModeName, NumObjectsCreated, NumOneShots);
+		AddResult(FString::Printf(TEXT("PlaySound2D_%s"), ModeName), 1, 0.0f, NumOneShots, TotalSeconds);
+
+		AudioDevice->StopAllSounds(true);
+		AudioDevice->FlushAudioRenderingCommands();
+	}
+
+	Settings->SubmixOverrideMode = PreviousMode;
+	FSoundBaseWrapperCache::Get().Empty();
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkCurves()
+{
+	struct FCurveCase
+	{
+		const TCHAR* Name;
+		Audio::EFaderCurve Curve;
+		float MinAlpha;
+		float MaxAlpha;
+	};
+
+	// Alpha ranges match the tables; Logarithmic alphas are decibels.
+	const FCurveCase Cases[] = {
+		{ TEXT("Linear"),      Audio::EFaderCurve::Linear,        0.0f, 1.0f  },
+		{ TEXT("SCurve"),      Audio::EFaderCurve::SCurve,        0.0f, 1.0f  },
+		{ TEXT("Sin"),         Audio::EFaderCurve::Sin,           0.0f, 1.0f  },
+		{ TEXT("Logarithmic"), Audio::EFaderCurve::Logarithmic, -80.0f, 24.0f },
+	};
+
+	constexpr int32 BatchSize = SoundClassMixerBenchmarkPrivate::CurveBatchSize;
+	constexpr int32 NumBatches = SoundClassMixerBenchmarkPrivate::NumCurveEvaluations / BatchSize;
+
+	TArray<float> Alphas;
+	TArray<float> Volumes;
+	Alphas.SetNumUninitialized(BatchSize);
+	Volumes.SetNumUninitialized(BatchSize);
+
+	// Keeps the evaluations observable so none of the loops are optimized away.
+	volatile float Sink = 0.0f;
+
+	for (const FCurveCase& Case : Cases)
+	{
+		// Stride through the range so consecutive lookups land in different table segments.
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			const float Fraction = static_cast<float>((Index * 389) % BatchSize) / (BatchSize - 1);
+			Alphas[Index] = FMath::Lerp(Case.MinAlpha, Case.MaxAlpha, Fraction);
+		}
+
+		// Scalar: one value per call, as GetVolume does per fader.
+		double StartTime = FPlatformTime::Seconds();
+		float Sum = 0.0f;
+		for (int32 Evaluation = 0; Evaluation < SoundClassMixerBenchmarkPrivate::NumCurveEvaluations; ++Evaluation)
+		{
+			Sum += FSimpleFader::AlphaToVolume(Alphas[Evaluation & (BatchSize - 1)], Case.Curve);
+		}
+		const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+		Sink = Sink + Sum;
+
+		// Batched: a whole array per call, as FSimpleFaderBank applies the curve.
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+		{
+			FSimpleFader::AlphaToVolume(Alphas, Volumes, Case.Curve);
+			Sink = Sink + Volumes[Batch & (BatchSize - 1)];
+		}
+		const double BatchedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AddResult(FString::Printf(TEXT("AlphaToVolume_Lut_%s_Scalar"), Case.Name), 1, 0.0f, SoundClassMixerBenchmarkPrivate::NumCurveEvaluations, ScalarSeconds);
+		AddResult(FString::Printf(TEXT("AlphaToVolume_Lut_%s_Batched"), Case.Name), BatchSize, 0.0f, NumBatches * BatchSize, BatchedSeconds);
+
+#if WITH_DEV_AUTOMATION_TESTS
+		// The functions the tables replaced; there is no batched form of them.
+		StartTime = FPlatformTime::Seconds();
+		Sum = 0.0f;
+		for (int32 Evaluation = 0; Evaluation < SoundClassMixerBenchmarkPrivate::NumCurveEvaluations; ++Evaluation)
+		{
+			Sum += FSimpleFader::AlphaToVolumeExactForTesting(Alphas[Evaluation & (BatchSize - 1)], Case.Curve);
+		}
+		const double ExactSeconds = FPlatformTime::Seconds() - StartTime;
+		Sink = Sink + Sum;
+
+		AddResult(FString::Printf(TEXT("AlphaToVolume_Exact_%s_Scalar"), Case.Name), 1, 0.0f, SoundClassMixerBenchmarkPrivate::NumCurveEvaluations, ExactSeconds);
+#endif
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::BenchmarkFaderBank()
+{
+	const Audio::EFaderCurve Curves[] = {
+		Audio::EFaderCurve::Linear, Audio::EFaderCurve::SCurve, Audio::EFaderCurve::Sin, Audio::EFaderCurve::Logarithmic
+	};
+
+	constexpr int32 NumFrames = SoundClassMixerBenchmarkPrivate::NumFaderBankFrames;
+	constexpr float DeltaTime = SoundClassMixerBenchmarkPrivate::FrameDeltaTime;
+
+	// Keeps the evaluations observable so none of the loops are optimized away.
+	volatile float Sink = 0.0f;
+
+	for (const int32 Count : SoundClassMixerBenchmarkPrivate::FaderBankCounts)
+	{
+		// Mixed curves, as channels would have; no fade completes within the run.
+		TArray<FSimpleFader> ScalarFaders;
+		ScalarFaders.SetNum(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			ScalarFaders[Index].SetVolume(1.0f);
+			ScalarFaders[Index].StartFade((Index & 1) ? 0.25f : 0.0f, SoundClassMixerBenchmarkPrivate::FadeDuration, Curves[Index % UE_ARRAY_COUNT(Curves)]);
+		}
+
+		TArray<FSimpleFader> BankedFaders = ScalarFaders;
+		FSimpleFaderBank Bank;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Bank.Add(Index, BankedFaders[Index]);
+		}
+
+		// Scalar: Update and GetVolume per fader, the per-channel path for envelopes.
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			float Sum = 0.0f;
+			for (FSimpleFader& Fader : ScalarFaders)
+			{
+				Fader.Update(DeltaTime);
+				Sum += Fader.GetVolume();
+			}
+			Sink = Sink + Sum;
+		}
+		const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Batched: one bank update, then the per-fader write back UpdateAudioClasses does.
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Bank.Update(DeltaTime);
+
+			float Sum = 0.0f;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Sum += Bank.Sync(Index, BankedFaders[Index]);
+			}
+			Sink = Sink + Sum;
+		}
+		const double BatchedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		float MaxDeviation = 0.0f;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(ScalarFaders[Index].GetVolume() - BankedFaders[Index].GetVolume()));
+		}
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Display, TEXT("FaderBank Count=%d: max deviation %g from the scalar faders."), Count, MaxDeviation);
+
+		AddResult(TEXT("FaderUpdate_Scalar"), Count, 1.0f, NumFrames * Count, ScalarSeconds);
+		AddResult(TEXT("FaderUpdate_Batched"), Count, 1.0f, NumFrames * Count, BatchedSeconds);
+	}
+}
+
+void USoundClassMixerBenchmarkCommandlet::AddResult(
+	const FString& Benchmark, const int32 Count, const float ActiveFraction, const int32 Iterations, const double TotalSeconds
+)
+{
+	FResult& Result = Results.AddDefaulted_GetRef();
+	Result.Benchmark      = Benchmark;
+	Result.Count          = Count;
+	Result.ActiveFraction = ActiveFraction;
+	Result.Iterations     = Iterations;
+	Result.TotalSeconds   = TotalSeconds;
+
+	UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Display, TEXT("%-40s Count=%-5d Active=%.2f %8.3f ms (%.1f ns/iteration)"),
+		*Benchmark, Count, ActiveFraction, TotalSeconds * 1000.0, TotalSeconds * 1.e9 / FMath::Max(1, Iterations));
+}
+
+bool USoundClassMixerBenchmarkCommandlet::WriteCsv(const FString& Filename) const
+{
+	FString Csv = TEXT("Benchmark,Count,ActiveFraction,Iterations,TotalMs,NsPerIteration\n");
+	for (const FResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%.3f,%d,%.4f,%.1f\n"),
+			*Result.Benchmark, Result.Count, Result.ActiveFraction, Result.Iterations,
+			Result.TotalSeconds * 1000.0, Result.TotalSeconds * 1.e9 / FMath::Max(1, Result.Iterations));
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Filename))
+	{
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Error, TEXT("Failed to write %s."), *Filename);
+		return false;
+	}
+	return true;
+}
+
+bool USoundClassMixerBenchmarkCommandlet::WriteJson(const FString& Filename) const
+{
+	// Same columns as the CSV, one object per row; benchmark names are plain identifiers, nothing to escape.
+	FString Json = TEXT("[\n");
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FResult& Result = Results[Index];
+		Json += FString::Printf(
+			TEXT("\t{ \"Benchmark\": \"%s\", \"Count\": %d, \"ActiveFraction\": %.3f, \"Iterations\": %d, \"TotalMs\": %.4f, \"NsPerIteration\": %.1f }%s\n"),
+			*Result.Benchmark, Result.Count, Result.ActiveFraction, Result.Iterations,
+			Result.TotalSeconds * 1000.0, Result.TotalSeconds * 1.e9 / FMath::Max(1, Result.Iterations),
+			Index + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("]\n");
+
+	if (!FFileHelper::SaveStringToFile(Json, *Filename))
+	{
+		UE_LOG(LogSoundClassMixerBenchmarkCommandlet, Error, TEXT("Failed to write %s."), *Filename);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "SoundClassMixerBenchmarkCommandlet.generated.h"
+
+class USoundClass;
+class USoundClassMixerSubsystem;
+
+/**
+ * Times the mixer's hot paths against synthetic SoundClasses and writes the results as CSV and JSON.
+ * Headless: UE4Editor-Cmd <Project> -run=SoundClassMixerBenchmark -nullrhi -nosound [-Output=<File.csv>] [-Frames=<N>]
+ * The JSON file is written next to the CSV one. The SoundClassMixer.Benchmarks automation test runs the same suite.
+ *
+ * Without an audio thread the game thread counts as the audio thread, so the Blueprint fade calls apply inline
+ * (SoundClassFadeTo_Inline). The coalesce, ring submit and drain stages are driven explicitly by the CommandPath_* rows.
+ * GatherSoundClasses, Gather_Manifest and Gather_AssetRegistry rows run over the project's assets plus 64 to 4096
+ * synthetic SoundClasses added to the asset registry, all already loaded, so only the lookup and registration are
+ * timed; the last two compare the cooked build's manifest path against the scan it skips.
+ * The subsystem rows drive it through its automation test hooks and are skipped in builds without them.
+ * FindSoundClassByName_* rows compare the FName index against the GetName() scan it replaced, at 1000 classes.
+ * WrapperGarbage_* rows time 10000 plays worth of wrappers with and without the cache, and the GC collecting them.
+ * PlaySound2D_* rows play 1000 one-shots through each SubmixOverrideMode; they need an audio device, so run without -nosound.
+ * AlphaToVolume_Lut_* rows time the curve lookup tables one value per call and through the batched AlphaToVolume;
+ * AlphaToVolume_Exact_* rows time the functions the tables replaced, in builds with automation tests.
+ * FaderUpdate_* rows compare per-fader updates against FSimpleFaderBank at 64, 1024 and 10240 running fades.
+ */
+UCLASS()
+class USoundClassMixerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USoundClassMixerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	struct FResult
+	{
+		FString Benchmark;
+		int32 Count = 0;
+		float ActiveFraction = 0.0f;
+		int32 Iterations = 0;
+		double TotalSeconds = 0.0;
+	};
+
+	/** Rows of the last Main run, in the order they were measured. */
+	const TArray<FResult>& GetResults() const { return Results; }
+
+private:
+
+	/** Unregisters everything and registers Count synthetic classes, four children per parent. */
+	void RegisterSyntheticClasses(USoundClassMixerSubsystem* Subsystem, int32 Count);
+
+	/** Grows the synthetic SoundClass assets the asset registry lists to Count, four children per parent. */
+	void AddSyntheticGatherAssets(int32 Count);
+
+	/** Unregisters the synthetic assets from the subsystem and the asset registry and lets them be collected. */
+	void RemoveSyntheticGatherAssets(USoundClassMixerSubsystem* Subsystem);
+
+	void BenchmarkGather(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkManifest(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkRegister(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkUpdate(USoundClassMixerSubsystem* Subsystem, int32 NumFrames);
+	void BenchmarkFadeCommands(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkCommandPath(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkNameLookup(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkWrapperCache();
+	void BenchmarkWrapperGarbage();
+	void BenchmarkOneShots(USoundClassMixerSubsystem* Subsystem);
+	void BenchmarkCurves();
+	void BenchmarkFaderBank();
+
+	void AddResult(const FString& Benchmark, int32 Count, float ActiveFraction, int32 Iterations, double TotalSeconds);
+
+	bool WriteCsv(const FString& Filename) const;
+	bool WriteJson(const FString& Filename) const;
+
+	/** Grown on demand, reused by every benchmark. */
+	UPROPERTY()
+		TArray<USoundClass*> SyntheticClasses;
+
+	/** Like SyntheticClasses, but each in its own package under /Game so the gathers find them. */
+	UPROPERTY()
+		TArray<USoundClass*> SyntheticGatherClasses;
+
+	TArray<FResult> Results;
+};
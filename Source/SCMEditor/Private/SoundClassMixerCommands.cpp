@@ -73,7 +73,7 @@ void FSoundClassMixerCommands::RegisterCommands(USoundClassMixerSubsystem* InSou
 				SoundClassMixerSubsystem->AdjustSoundClassVolumeInternal(
 					FoundSoundClass,
 					AdjustVolumeDuration, AdjustVolumeLevel,
-					FoundSoundClass->Properties.Volume > AdjustVolumeLevel,
+					SoundClassMixerSubsystem->GetSoundClassVolumeInternal(FoundSoundClass) > AdjustVolumeLevel,
 					EAudioFaderCurve::Linear 
 				);
 			}
@@ -103,7 +103,7 @@ void FSoundClassMixerCommands::RegisterCommands(USoundClassMixerSubsystem* InSou
 					return;
 				}
 
-				const FSoundSubSysProperties* FoundSoundClassProps = SoundClassMixerSubsystem->SoundClassMap.Find(FoundSoundClass);
+				const FSoundSubSysProperties* FoundSoundClassProps = SoundClassMixerSubsystem->FindSoundClassProperties(FoundSoundClass);
 				checkf(FoundSoundClassProps, TEXT("SoundClass Properties are not found."))
 				
 				SoundClassMixerSubsystem->SetSoundClassVolumeInternal(
@@ -149,7 +149,7 @@ void FSoundClassMixerCommands::RegisterCommands(USoundClassMixerSubsystem* InSou
 						return;
 					}
 
-					const FSoundSubSysProperties* FoundSoundClassProps = SoundClassMixerSubsystem->SoundSubmixMap.Find(FoundSubmixClass);
+					const FSoundSubSysProperties* FoundSoundClassProps = SoundClassMixerSubsystem->FindSoundSubmixProperties(FoundSubmixClass);
 					checkf(FoundSoundClassProps, TEXT("SoundSubmix Properties are not found."))
 				
 					SoundClassMixerSubsystem->SetSoundSubmixVolumeInternal(
@@ -189,7 +189,7 @@ void FSoundClassMixerCommands::RegisterCommands(USoundClassMixerSubsystem* InSou
 				SoundClassMixerSubsystem->AdjustSoundSubmixVolumeInternal(
 					FoundSoundSubmix,
 					AdjustVolumeDuration, AdjustVolumeLevel,
-					FoundSoundSubmix->OutputVolume > AdjustVolumeLevel,
+					SoundClassMixerSubsystem->GetSoundSubmixVolumeInternal(FoundSoundSubmix) > AdjustVolumeLevel,
 					EAudioFaderCurve::Linear 
 				);
 			}
@@ -243,8 +243,8 @@ void FSoundClassMixerCommands::OnDrawDebug_SoundClass(UCanvas* Canvas, APlayerCo
 	Table.SetPadding(3.f);
 	for (const USoundClass* Key : Keys)
 	{
-		const FSoundSubSysProperties* Props = SoundClassMixerSubsystem->SoundClassMap.Find(Key);
-		Table.AddElement("Current Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), Key->Properties.Volume), FLinearColor::White);
+		const FSoundSubSysProperties* Props = SoundClassMixerSubsystem->FindSoundClassProperties(Key);
+		Table.AddElement("Current Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), SoundClassMixerSubsystem->GetSoundClassVolumeInternal(Key)), FLinearColor::White);
 		Table.AddElement("Target Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), Props->Fader.GetTargetVolume()), FLinearColor::White);
 	}
 	
@@ -284,8 +284,8 @@ void FSoundClassMixerCommands::OnDrawDebug_SoundSubmix(UCanvas* Canvas, APlayerC
 	Table.SetPadding(3.f);
 	for (const USoundSubmix* Key : Keys)
 	{
-		const FSoundSubSysProperties* Props = SoundClassMixerSubsystem->SoundSubmixMap.Find(Key);
-		Table.AddElement("Current Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), Key->OutputVolume), FLinearColor::White);
+		const FSoundSubSysProperties* Props = SoundClassMixerSubsystem->FindSoundSubmixProperties(Key);
+		Table.AddElement("Current Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), SoundClassMixerSubsystem->GetSoundSubmixVolumeInternal(Key)), FLinearColor::White);
 		Table.AddElement("Target Volume", Key->GetName(), FString::Printf(TEXT("%.4f"), Props->Fader.GetTargetVolume()), FLinearColor::White);
 	}
 	
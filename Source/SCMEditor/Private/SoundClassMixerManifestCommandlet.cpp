@@ -0,0 +1,86 @@
+﻿#include "SoundClassMixerManifestCommandlet.h"
+
+#include "SoundClassMixerManifest.h"
+#include "SoundClassMixerSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Sound/SoundClass.h"
+#include "Sound/SoundSubmix.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogSoundClassMixerManifestCommandlet, Log, All);
+
+
+USoundClassMixerManifestCommandlet::USoundClassMixerManifestCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USoundClassMixerManifestCommandlet::Main(const FString& Params)
+{
+	const USoundClassMixerSettings* Settings = GetDefault<USoundClassMixerSettings>();
+	const FSoundClassMixerAssetFilter& AssetFilter = Settings->GetAssetFilter();
+
+	FString OutputFilename = FSoundClassMixerManifest::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Output="), OutputFilename);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FSoundClassMixerManifest Manifest;
+	Manifest.AssetFilterHash = Settings->GetAssetFilterHash();
+
+	FARFilter SoundClassFilter;
+	SoundClassFilter.ClassNames.Add(USoundClass::StaticClass()->GetFName());
+	SoundClassFilter.bRecursiveClasses = true;
+
+	TArray<FAssetData> AssetDataList_SoundClasses;
+	AssetRegistry.GetAssets(SoundClassFilter, AssetDataList_SoundClasses);
+	for (const FAssetData& AssetData : AssetDataList_SoundClasses)
+	{
+		if (!AssetFilter.IsSoundClassIncluded(AssetData))
+		{
+			continue;
+		}
+
+		if (const USoundClass* SoundClass = Cast<USoundClass>(AssetData.GetAsset()))
+		{
+			FSoundClassMixerManifestEntry& Entry = Manifest.SoundClasses.AddDefaulted_GetRef();
+			Entry.Path = AssetData.ToSoftObjectPath();
+			Entry.DefaultVolume = SoundClass->Properties.Volume;
+		}
+	}
+
+	FARFilter SoundSubmixFilter;
+	SoundSubmixFilter.ClassNames.Add(USoundSubmix::StaticClass()->GetFName());
+	SoundSubmixFilter.bRecursiveClasses = true;
+
+	TArray<FAssetData> AssetDataList_SoundSubmixes;
+	AssetRegistry.GetAssets(SoundSubmixFilter, AssetDataList_SoundSubmixes);
+	for (const FAssetData& AssetData : AssetDataList_SoundSubmixes)
+	{
+		if (!AssetFilter.IsSoundSubmixIncluded(AssetData))
+		{
+			continue;
+		}
+
+		if (const USoundSubmix* SoundSubmix = Cast<USoundSubmix>(AssetData.GetAsset()))
+		{
+			FSoundClassMixerManifestEntry& Entry = Manifest.SoundSubmixes.AddDefaulted_GetRef();
+			Entry.Path = AssetData.ToSoftObjectPath();
+			Entry.DefaultVolume = SoundSubmix->OutputVolume;
+		}
+	}
+
+	if (!Manifest.SaveToFile(OutputFilename))
+	{
+		UE_LOG(LogSoundClassMixerManifestCommandlet, Error, TEXT("Failed to write %s."), *OutputFilename);
+		return 1;
+	}
+
+	UE_LOG(LogSoundClassMixerManifestCommandlet, Display, TEXT("Wrote %d SoundClasses and %d SoundSubmixes to %s."),
+		Manifest.SoundClasses.Num(), Manifest.SoundSubmixes.Num(), *OutputFilename);
+	return 0;
+}
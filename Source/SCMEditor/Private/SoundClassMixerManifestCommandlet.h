@@ -0,0 +1,22 @@
+﻿#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "SoundClassMixerManifestCommandlet.generated.h"
+
+/**
+ * Writes FSoundClassMixerManifest for cooked builds.
+ * Run before packaging: UE4Editor-Cmd <Project> -run=SoundClassMixerManifest [-Output=<File>]
+ * The default output lives under Content/SoundClassMixer, which the runtime module stages as a
+ * runtime dependency; a custom -Output path has to be staged by the project.
+ */
+UCLASS()
+class USoundClassMixerManifestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USoundClassMixerManifestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
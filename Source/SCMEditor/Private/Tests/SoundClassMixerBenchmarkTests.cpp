@@ -0,0 +1,44 @@
+﻿#include "SoundClassMixerBenchmarkCommandlet.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Runs the benchmark commandlet's suite from the automation framework and reports every row.
+ * Headless: UE4Editor-Cmd <Project> -ExecCmds="Automation RunTests SoundClassMixer.Benchmarks; Quit" -nullrhi -nosound
+ * CSV and JSON results land in Saved/SoundClassMixer/BenchmarkAutomation.*, next to the commandlet's.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSoundClassMixerBenchmarkTest,
+	"SoundClassMixer.Benchmarks",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSoundClassMixerBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const FString OutputFilename = FPaths::ProjectSavedDir() / TEXT("SoundClassMixer") / TEXT("BenchmarkAutomation.csv");
+
+	// Rooted since the wrapper benchmarks run the garbage collector.
+	USoundClassMixerBenchmarkCommandlet* Benchmark = NewObject<USoundClassMixerBenchmarkCommandlet>();
+	Benchmark->AddToRoot();
+	const int32 ReturnCode = Benchmark->Main(FString::Printf(TEXT("-Output=\"%s\""), *OutputFilename));
+	Benchmark->RemoveFromRoot();
+
+	TestEqual(TEXT("Benchmark suite ran and wrote its results"), ReturnCode, 0);
+	TestTrue(TEXT("Benchmark suite produced results"), Benchmark->GetResults().Num() > 0);
+
+	for (const USoundClassMixerBenchmarkCommandlet::FResult& Result : Benchmark->GetResults())
+	{
+		AddInfo(FString::Printf(
+			TEXT("%s: Count %d, ActiveFraction %.3f, %.4f ms total, %.1f ns per iteration"),
+			*Result.Benchmark, Result.Count, Result.ActiveFraction,
+			Result.TotalSeconds * 1000.0, Result.TotalSeconds * 1.e9 / FMath::Max(1, Result.Iterations)
+		));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
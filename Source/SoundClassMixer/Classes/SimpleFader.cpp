@@ -1,15 +1,197 @@
 ﻿#include "SimpleFader.h"
 
+#include "Algo/BinarySearch.h"
+#include "Curves/RichCurve.h"
+#include "Math/VectorRegister.h"
+
+namespace SimpleFaderPrivate
+{
+	/**
+	 * Samples of a curve at NumSegments + 1 evenly spaced alphas in [MinAlpha, MaxAlpha].
+	 * Linear interpolation error is bounded by Step^2 / 8 * max|f''| over the range.
+	 */
+	template <int32 NumSegments>
+	struct FCurveTable
+	{
+		float MinAlpha;
+		float InvStep;
+		float Values[NumSegments + 1];
+
+		FCurveTable(const float InMinAlpha, const float InMaxAlpha, TFunctionRef<float(float)> InFunction)
+			: MinAlpha(InMinAlpha)
+			, InvStep(NumSegments / (InMaxAlpha - InMinAlpha))
+		{
+			const float Step = (InMaxAlpha - InMinAlpha) / NumSegments;
+			for (int32 Index = 0; Index <= NumSegments; ++Index)
+			{
+				Values[Index] = InFunction(InMinAlpha + Step * Index);
+			}
+		}
+
+		/** False when the alpha is outside the table (or NaN). */
+		FORCEINLINE bool Evaluate(const float InAlpha, float& OutVolume) const
+		{
+			const float Position = (InAlpha - MinAlpha) * InvStep;
+			if (!(Position >= 0.0f && Position <= static_cast<float>(NumSegments)))
+			{
+				return false;
+			}
+
+			const int32 Index = FMath::Min(static_cast<int32>(Position), NumSegments - 1);
+			OutVolume = FMath::Lerp(Values[Index], Values[Index + 1], Position - static_cast<float>(Index));
+			return true;
+		}
+
+		/** Evaluate for four alphas at once; false, with nothing written, when any of them is outside the table. */
+		FORCEINLINE bool Evaluate4(const float* InAlphas, float* OutVolumes) const
+		{
+			const VectorRegister Position = VectorMultiply(VectorSubtract(VectorLoad(InAlphas), VectorSetFloat1(MinAlpha)), VectorSetFloat1(InvStep));
+
+			// NaN fails both comparisons.
+			const VectorRegister InRange = VectorBitwiseAnd(
+				VectorCompareGE(Position, VectorZero()),
+				VectorCompareLE(Position, VectorSetFloat1(static_cast<float>(NumSegments)))
+			);
+			if (VectorMaskBits(InRange) != 0xF)
+			{
+				return false;
+			}
+
+			const VectorRegister Segment = VectorTruncate(VectorMin(Position, VectorSetFloat1(static_cast<float>(NumSegments - 1))));
+			const VectorRegister Fraction = VectorSubtract(Position, Segment);
+
+			// The gather stays scalar, the interpolation is vectorized.
+			float Segments[4];
+			float From[4];
+			float To[4];
+			VectorStore(Segment, Segments);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				const int32 Index = static_cast<int32>(Segments[Lane]);
+				From[Lane] = Values[Index];
+				To[Lane] = Values[Index + 1];
+			}
+
+			const VectorRegister FromVolume = VectorLoad(From);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(To), FromVolume), Fraction, FromVolume), OutVolumes);
+			return true;
+		}
+	};
+
+	// f'' peaks at pi^2/2 (SCurve) and pi^2/4 (Sin): 1/256 steps keep the error under 1e-5.
+	using FUnitCurveTable = FCurveTable<256>;
+
+	// 10^(dB/20) has f''/f = (ln(10)/20)^2: 0.25 dB steps keep the relative error near 1e-4.
+	using FDecibelCurveTable = FCurveTable<416>;
+}
+
+FSimpleFaderEnvelope::FSimpleFaderEnvelope(TArray<FSimpleFaderEnvelopeKey> InKeys)
+	: Keys(MoveTemp(InKeys))
+{
+	for (FSimpleFaderEnvelopeKey& Key : Keys)
+	{
+		Key.Time = FMath::Max(0.0f, Key.Time);
+		Key.Volume = FMath::Max(0.0f, Key.Volume);
+	}
+
+	Keys.StableSort([](const FSimpleFaderEnvelopeKey& A, const FSimpleFaderEnvelopeKey& B) { return A.Time < B.Time; });
+}
+
+FSimpleFaderEnvelope FSimpleFaderEnvelope::FromRichCurve(const FRichCurve& InCurve, const float SampleInterval)
+{
+	// Bounds the table for long curves, the interval is stretched instead.
+	constexpr int32 MaxSamples = 4096;
+
+	float StartTime = 0.0f;
+	float EndTime = 0.0f;
+	InCurve.GetTimeRange(StartTime, EndTime);
+	StartTime = FMath::Max(0.0f, StartTime);
+	EndTime = FMath::Max(StartTime, EndTime);
+
+	const int32 NumSamples = FMath::Clamp(FMath::CeilToInt((EndTime - StartTime) / FMath::Max(SampleInterval, KINDA_SMALL_NUMBER)) + 1, 1, MaxSamples);
+	const float Step = NumSamples > 1 ? (EndTime - StartTime) / (NumSamples - 1) : 0.0f;
+
+	TArray<FSimpleFaderEnvelopeKey> Keys;
+	Keys.Reserve(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		FSimpleFaderEnvelopeKey& Key = Keys.AddDefaulted_GetRef();
+		Key.Time = StartTime + Step * Index;
+		Key.Volume = InCurve.Eval(Key.Time, 1.0f);
+	}
+
+	return FSimpleFaderEnvelope(MoveTemp(Keys));
+}
+
+float FSimpleFaderEnvelope::Evaluate(const float InTime, const float InStartVolume) const
+{
+	if (Keys.Num() == 0)
+	{
+		return InStartVolume;
+	}
+
+	// First key strictly after InTime closes the current segment.
+	const int32 KeyIndex = Algo::UpperBoundBy(Keys, InTime, &FSimpleFaderEnvelopeKey::Time);
+	if (KeyIndex >= Keys.Num())
+	{
+		return Keys.Last().Volume;
+	}
+
+	const FSimpleFaderEnvelopeKey& Key = Keys[KeyIndex];
+	const float FromTime = KeyIndex > 0 ? Keys[KeyIndex - 1].Time : 0.0f;
+	const float FromVolume = KeyIndex > 0 ? Keys[KeyIndex - 1].Volume : InStartVolume;
+
+	const float SegmentDuration = Key.Time - FromTime;
+	const float Alpha = SegmentDuration > SMALL_NUMBER ? FMath::Clamp((InTime - FromTime) / SegmentDuration, 0.0f, 1.0f) : 1.0f;
+
+	// Same value spaces as FSimpleFader::StartFade: linear for the shaped curves, decibels for Logarithmic.
+	if (Key.Curve == Audio::EFaderCurve::Logarithmic)
+	{
+		constexpr float DecibelFloor = KINDA_SMALL_NUMBER; // -80dB
+		const float FromDecibels = Audio::ConvertToDecibels(FromVolume, DecibelFloor);
+		const float ToDecibels = Audio::ConvertToDecibels(Key.Volume, DecibelFloor);
+		return FSimpleFader::AlphaToVolume(FMath::Lerp(FromDecibels, ToDecibels, Alpha), Key.Curve);
+	}
+
+	return FSimpleFader::AlphaToVolume(FMath::Lerp(FromVolume, Key.Volume, Alpha), Key.Curve);
+}
+
+
+// =====================================================================================================================
+
+
 FSimpleFader::FSimpleFader()
 	: CurrentVolume(1.0f)
 	, TargetVolume(1.0f)
+	, StartVolume(1.0f)
 	, FadeDuration(-1.0f)
 	, ElapsedTime(0.0f)
 	, FadeCurve(Audio::EFaderCurve::Linear)
+	, Envelope(nullptr)
+	, EnvelopeStartVolume(1.0f)
 {}
 
+const SimpleFaderPrivate::FUnitCurveTable& FSimpleFader::GetSCurveTable()
+{
+	static const SimpleFaderPrivate::FUnitCurveTable Table(0.0f, 1.0f, [](const float Alpha) { return AlphaToVolumeExact(Alpha, Audio::EFaderCurve::SCurve); });
+	return Table;
+}
+
+const SimpleFaderPrivate::FUnitCurveTable& FSimpleFader::GetSinTable()
+{
+	static const SimpleFaderPrivate::FUnitCurveTable Table(0.0f, 1.0f, [](const float Alpha) { return AlphaToVolumeExact(Alpha, Audio::EFaderCurve::Sin); });
+	return Table;
+}
+
+const SimpleFaderPrivate::FDecibelCurveTable& FSimpleFader::GetLogarithmicTable()
+{
+	static const SimpleFaderPrivate::FDecibelCurveTable Table(-80.0f, 24.0f, [](const float Alpha) { return AlphaToVolumeExact(Alpha, Audio::EFaderCurve::Logarithmic); });
+	return Table;
+}
+
 float FSimpleFader::AlphaToVolume(const float InAlpha, const Audio::EFaderCurve InCurve)
 {
+	float Volume = 1.0f;
 	switch (InCurve)
 	{
 	case Audio::EFaderCurve::Linear:
@@ -19,13 +201,124 @@ float FSimpleFader::AlphaToVolume(const float InAlpha, const Audio::EFaderCurve
 
 	case Audio::EFaderCurve::SCurve:
 	{
-		float Volume = 0.5f * Audio::FastSin(PI * InAlpha - HALF_PI) + 0.5f;
+		if (GetSCurveTable().Evaluate(InAlpha, Volume))
+		{
+			return Volume;
+		}
+		break;
+	}
+
+	case Audio::EFaderCurve::Sin:
+	{
+		if (GetSinTable().Evaluate(InAlpha, Volume))
+		{
+			return Volume;
+		}
+		break;
+	}
+
+	case Audio::EFaderCurve::Logarithmic:
+	{
+		if (GetLogarithmicTable().Evaluate(InAlpha, Volume))
+		{
+			return Volume;
+		}
+		break;
+	}
+
+	default:
+	{
+		static_assert(static_cast<int32>(Audio::EFaderCurve::Count) == 4, "Possible missing switch case coverage for EAudioFade");
+	}
+	break;
+	}
+
+	return AlphaToVolumeExact(InAlpha, InCurve);
+}
+
+void FSimpleFader::AlphaToVolume(TArrayView<const float> InAlphas, TArrayView<float> OutVolumes, const Audio::EFaderCurve InCurve)
+{
+	check(InAlphas.Num() == OutVolumes.Num());
+
+	const int32 Num = InAlphas.Num();
+	const int32 NumVectorized = Num - (Num % 4);
+
+	auto EvaluateTable = [&](const auto& Table)
+	{
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			if (!Table.Evaluate4(&InAlphas[Index], &OutVolumes[Index]))
+			{
+				for (int32 Lane = Index; Lane < Index + 4; ++Lane)
+				{
+					OutVolumes[Lane] = AlphaToVolume(InAlphas[Lane], InCurve);
+				}
+			}
+		}
+
+		for (int32 Index = NumVectorized; Index < Num; ++Index)
+		{
+			OutVolumes[Index] = AlphaToVolume(InAlphas[Index], InCurve);
+		}
+	};
+
+	switch (InCurve)
+	{
+	case Audio::EFaderCurve::Linear:
+	{
+		FMemory::Memcpy(OutVolumes.GetData(), InAlphas.GetData(), Num * sizeof(float));
+		break;
+	}
+
+	case Audio::EFaderCurve::SCurve:
+	{
+		EvaluateTable(GetSCurveTable());
+		break;
+	}
+
+	case Audio::EFaderCurve::Sin:
+	{
+		EvaluateTable(GetSinTable());
+		break;
+	}
+
+	case Audio::EFaderCurve::Logarithmic:
+	{
+		EvaluateTable(GetLogarithmicTable());
+		break;
+	}
+
+	default:
+	{
+		static_assert(static_cast<int32>(Audio::EFaderCurve::Count) == 4, "Possible missing switch case coverage for EAudioFade");
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			OutVolumes[Index] = AlphaToVolumeExact(InAlphas[Index], InCurve);
+		}
+	}
+	break;
+	}
+}
+
+float FSimpleFader::AlphaToVolumeExact(const float InAlpha, const Audio::EFaderCurve InCurve)
+{
+	switch (InCurve)
+	{
+	case Audio::EFaderCurve::Linear:
+	{
+		return InAlpha;
+	}
+
+	case Audio::EFaderCurve::SCurve:
+	{
+		float Volume = 0.5f * FMath::Sin(PI * InAlpha - HALF_PI) + 0.5f;
 		return FMath::Max(0.0f, Volume);
 	}
 
 	case Audio::EFaderCurve::Sin:
 	{
-		float Volume = Audio::FastSin(HALF_PI * InAlpha);
+		float Volume = FMath::Sin(HALF_PI * InAlpha);
 		return FMath::Max(0.0f, Volume);
 	}
 
@@ -117,6 +410,7 @@ void FSimpleFader::SetVolume(const float InVolume)
 	FadeCurve = Audio::EFaderCurve::Linear;
 	FadeDuration = -1.0f;
 	TargetVolume = InVolume;
+	Envelope = nullptr;
 }
 
 
@@ -131,6 +425,9 @@ void FSimpleFader::StartFade(const float InVolume, const float InDuration, const
 		return;
 	}
 
+	// An interrupted envelope leaves a linear CurrentVolume, which the conversions below expect.
+	Envelope = nullptr;
+
 	// When idle, internal alpha can drift from the last applied output volume (e.g. asset defaults).
 	if (!IsFading())
 	{
@@ -163,12 +460,38 @@ void FSimpleFader::StartFade(const float InVolume, const float InDuration, const
 		TargetVolume = Audio::ConvertToDecibels(InVolume, DecibelFloor);
 	}
 
+	StartVolume = CurrentVolume;
 	ElapsedTime = 0.0f;
 	FadeCurve = InCurve;
 	FadeDuration = InDuration;
 }
 
 
+void FSimpleFader::StartEnvelope(const FSimpleFaderEnvelope* InEnvelope)
+{
+	if (!InEnvelope || InEnvelope->IsEmpty())
+	{
+		return;
+	}
+
+	if (InEnvelope->GetDuration() <= 0.0f)
+	{
+		SetVolume(InEnvelope->GetFinalVolume());
+		return;
+	}
+
+	EnvelopeStartVolume = GetVolume();
+
+	// Envelope output is stored already converted, so the fader itself stays linear.
+	Envelope = InEnvelope;
+	FadeCurve = Audio::EFaderCurve::Linear;
+	ElapsedTime = 0.0f;
+	FadeDuration = InEnvelope->GetDuration();
+	TargetVolume = InEnvelope->GetFinalVolume();
+	CurrentVolume = InEnvelope->Evaluate(0.0f, EnvelopeStartVolume);
+}
+
+
 void FSimpleFader::StopFade()
 {
 	if (FadeCurve == Audio::EFaderCurve::Logarithmic)
@@ -179,6 +502,7 @@ void FSimpleFader::StopFade()
 	FadeCurve = Audio::EFaderCurve::Linear;
 	ElapsedTime = 0.0;
 	FadeDuration = -1.0f;
+	Envelope = nullptr;
 }
 
 
@@ -189,36 +513,47 @@ float FSimpleFader::GetVolumeAfterTime(float InDeltaTime) const
 {
 	InDeltaTime = FMath::Max(0.0f, InDeltaTime);
 
-	// Keep stepping towards our target until we hit our stop time & Clamp
-	float FutureAlpha = CurrentVolume;
-	const float Duration = ElapsedTime + InDeltaTime;
+	if (Envelope)
+	{
+		return Envelope->Evaluate(ElapsedTime + InDeltaTime, EnvelopeStartVolume);
+	}
 
-	if (Duration < FadeDuration)
+	if (!IsFading())
 	{
-		// Choose min/max bound and clamp dt to prevent unwanted spikes in volume
-		float MinValue;
-		float MaxValue;
-		if (CurrentVolume < TargetVolume)
-		{
-			MinValue = CurrentVolume;
-			MaxValue = TargetVolume;
-		}
-		else
-		{
-			MinValue = TargetVolume;
-			MaxValue = CurrentVolume;
-		}
+		return AlphaToVolume(CurrentVolume, FadeCurve);
+	}
 
-		FutureAlpha = CurrentVolume + ((TargetVolume - CurrentVolume) * InDeltaTime / (FadeDuration - ElapsedTime));
-		FutureAlpha = FMath::Clamp(FutureAlpha, MinValue, MaxValue);
+	return AlphaToVolume(EvaluateFade(ElapsedTime + InDeltaTime), FadeCurve);
+}
+
+
+float FSimpleFader::EvaluateFade(const float InElapsedTime) const
+{
+	// Closed form from the fade's start: the result only depends on the elapsed time, not on how it was stepped.
+	if (FadeDuration <= InElapsedTime)
+	{
+		return TargetVolume;
 	}
 
-	return AlphaToVolume(FutureAlpha, FadeCurve);
+	return FMath::Lerp(StartVolume, TargetVolume, FMath::Max(0.0f, InElapsedTime) / FadeDuration);
 }
 
 
 void FSimpleFader::Update(float InDeltaTime)
 {
+	if (Envelope)
+	{
+		ElapsedTime += InDeltaTime;
+		if (FadeDuration <= ElapsedTime)
+		{
+			SetVolume(TargetVolume);
+			return;
+		}
+
+		CurrentVolume = Envelope->Evaluate(ElapsedTime, EnvelopeStartVolume);
+		return;
+	}
+
 	// Query fading state before incrementing elapsed time (matches Audio::FVolumeFader).
 	const bool bIsFading = IsFading();
 
@@ -236,25 +571,26 @@ void FSimpleFader::Update(float InDeltaTime)
 		return;
 	}
 
-	// Keep stepping towards target and clamp until fade duration has expired.
-	float MinValue;
-	float MaxValue;
-	if (CurrentVolume < TargetVolume)
-	{
-		MinValue = CurrentVolume;
-		MaxValue = TargetVolume;
-	}
-	else
+	CurrentVolume = EvaluateFade(ElapsedTime);
+
+	if (InDeltaTime > SMALL_NUMBER && FMath::IsNearlyEqual(CurrentVolume, TargetVolume))
 	{
-		MinValue = TargetVolume;
-		MaxValue = CurrentVolume;
+		StopFade();
 	}
+}
 
-	CurrentVolume += (TargetVolume - CurrentVolume) * InDeltaTime / (FadeDuration - ElapsedTime);
-	CurrentVolume = FMath::Clamp(CurrentVolume, MinValue, MaxValue);
 
-	if (InDeltaTime > SMALL_NUMBER && FMath::IsNearlyEqual(CurrentVolume, TargetVolume))
+float FSimpleFader::ConsumeFixedTimeSteps(const float InDeltaTime, const float InFixedTimeStep, float& InOutAccumulator)
+{
+	if (InFixedTimeStep <= 0.0f)
 	{
-		StopFade();
+		return InDeltaTime;
 	}
+
+	// Faders evaluate in closed form, so one update of N steps equals N updates of one step.
+	InOutAccumulator += InDeltaTime;
+	const float NumSteps = FMath::FloorToFloat(InOutAccumulator / InFixedTimeStep);
+	const float SteppedTime = NumSteps * InFixedTimeStep;
+	InOutAccumulator -= SteppedTime;
+	return SteppedTime;
 }
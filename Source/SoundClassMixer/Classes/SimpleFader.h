@@ -2,6 +2,55 @@
 
 #include "DSP/VolumeFader.h"
 
+struct FRichCurve;
+
+namespace SimpleFaderPrivate
+{
+	template <int32 NumSegments>
+	struct FCurveTable;
+}
+
+/** Envelope point; the segment from the previous key to this one is shaped by Curve. */
+struct FSimpleFaderEnvelopeKey
+{
+	float Time   = 0.0f;
+	float Volume = 1.0f;
+
+	Audio::EFaderCurve Curve = Audio::EFaderCurve::Linear;
+};
+
+/**
+ * Immutable multi-segment automation (dip, hold, recover...) run by FSimpleFader::StartEnvelope.
+ * Each segment behaves like a StartFade between its two keys; the first segment starts from
+ * the fader's volume at the time the envelope is started.
+ */
+class SOUNDCLASSMIXER_API FSimpleFaderEnvelope
+{
+public:
+	FSimpleFaderEnvelope() = default;
+
+	/** Keys are sorted by time, negative times are clamped to zero. */
+	explicit FSimpleFaderEnvelope(TArray<FSimpleFaderEnvelopeKey> InKeys);
+
+	/** Bakes the curve into linear keys every SampleInterval seconds, in curve time. */
+	static FSimpleFaderEnvelope FromRichCurve(const FRichCurve& InCurve, float SampleInterval);
+
+	/**
+	 * Returns the volume InTime seconds into the envelope, given the volume it started from.
+	 */
+	float Evaluate(float InTime, float InStartVolume) const;
+
+	float GetDuration() const { return Keys.Num() > 0 ? Keys.Last().Time : 0.0f; }
+	float GetFinalVolume() const { return Keys.Num() > 0 ? Keys.Last().Volume : 1.0f; }
+	bool IsEmpty() const { return Keys.Num() == 0; }
+
+	const TArray<FSimpleFaderEnvelopeKey>& GetKeys() const { return Keys; }
+
+private:
+	TArray<FSimpleFaderEnvelopeKey> Keys;
+};
+
+
 /** Control-rate fader for managing volume fades of various standard shapes. */
 class SOUNDCLASSMIXER_API FSimpleFader
 {
@@ -63,6 +112,12 @@ public:
 	 */
 	void StartFade(float InVolume, float InDuration, Audio::EFaderCurve InCurve);
 
+	/**
+	 * Runs the envelope from the current volume; the envelope must outlive the fade.
+	 * Interrupted by SetVolume, StartFade and StopFade like any other fade.
+	 */
+	void StartEnvelope(const FSimpleFaderEnvelope* InEnvelope);
+
 	/**
 	 * Stops fade, maintaining the current value as the target.
 	 */
@@ -73,10 +128,45 @@ public:
 	 */
 	void Update(float InDeltaTime);
 
-private:
-	/** Converts value to final resulting volume */
+	/**
+	 * Returns the whole InFixedTimeStep steps covered by the accumulated time, to update faders by, and keeps
+	 * the remainder in InOutAccumulator for the next call. A non-positive step returns InDeltaTime unchanged.
+	 */
+	static float ConsumeFixedTimeSteps(float InDeltaTime, float InFixedTimeStep, float& InOutAccumulator);
+
+	/**
+	 * Converts value to final resulting volume.
+	 * SCurve/Sin over [0, 1] and Logarithmic over [-80, 24] dB read lookup tables, built on first use, with
+	 * linear interpolation; max error against AlphaToVolumeExact is ~1e-5 absolute for SCurve/Sin
+	 * and ~1e-4 relative (0.001 dB) for Logarithmic. Values outside the tables use the exact path.
+	 */
 	static float AlphaToVolume(float InAlpha, Audio::EFaderCurve InCurve);
 
+	/**
+	 * AlphaToVolume over a whole array with a single curve, see FSimpleFaderBank.
+	 * Table lookups and interpolation run four values at a time; values outside the tables use the exact path.
+	 */
+	static void AlphaToVolume(TArrayView<const float> InAlphas, TArrayView<float> OutVolumes, Audio::EFaderCurve InCurve);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** The curve functions behind the lookup tables, for tests and benchmarks measuring against them. */
+	static float AlphaToVolumeExactForTesting(float InAlpha, Audio::EFaderCurve InCurve) { return AlphaToVolumeExact(InAlpha, InCurve); }
+#endif
+
+private:
+	friend FSimpleFaderEnvelope;
+	friend class FSimpleFaderBank;
+
+	static float AlphaToVolumeExact(float InAlpha, Audio::EFaderCurve InCurve);
+
+	/** Lookup tables behind AlphaToVolume, built on first use. */
+	static const SimpleFaderPrivate::FCurveTable<256>& GetSCurveTable();
+	static const SimpleFaderPrivate::FCurveTable<256>& GetSinTable();
+	static const SimpleFaderPrivate::FCurveTable<416>& GetLogarithmicTable();
+
+	/** Fade value (pre AlphaToVolume) InElapsedTime seconds after StartFade. */
+	float EvaluateFade(float InElapsedTime) const;
+
 	/** Current value used to linear interpolate over update delta
 	  * (Normalized value for non-log, -80dB to 0dB for log)
 	  */
@@ -87,6 +177,9 @@ private:
 	  */
 	float TargetVolume;
 
+	/** Value CurrentVolume had when the fade started, same space as CurrentVolume */
+	float StartVolume;
+
 	/** Duration fader is to perform fade */
 	float FadeDuration;
 
@@ -95,4 +188,10 @@ private:
 
 	/** Audio fader curve to use */
 	Audio::EFaderCurve FadeCurve;
+
+	/** Envelope being run, null for single segment fades. Not owned. */
+	const FSimpleFaderEnvelope* Envelope;
+
+	/** Output volume when the envelope was started */
+	float EnvelopeStartVolume;
 };
\ No newline at end of file
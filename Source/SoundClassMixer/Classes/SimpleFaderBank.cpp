@@ -0,0 +1,207 @@
+﻿#include "SimpleFaderBank.h"
+
+#include "Math/VectorRegister.h"
+
+namespace SimpleFaderBankPrivate
+{
+	constexpr int32 NumFloatsPerVector = 4;
+
+	/** Advances NumFloatsPerVector fades starting at the given pointers, same closed form as FSimpleFader::EvaluateFade. */
+	FORCEINLINE void UpdateVector(
+		const float* StartVolume, const float* TargetVolume, const float* FadeDuration, float* ElapsedTime, float* CurrentVolume,
+		const VectorRegister& DeltaTime
+	)
+	{
+		const VectorRegister Start    = VectorLoad(StartVolume);
+		const VectorRegister Target   = VectorLoad(TargetVolume);
+		const VectorRegister Duration = VectorLoad(FadeDuration);
+		const VectorRegister Elapsed  = VectorAdd(VectorLoad(ElapsedTime), DeltaTime);
+
+		const VectorRegister Alpha = VectorMin(VectorDivide(VectorMax(Elapsed, VectorZero()), Duration), VectorOne());
+		const VectorRegister Current = VectorMultiplyAdd(VectorSubtract(Target, Start), Alpha, Start);
+
+		// Expired fades land exactly on their target, as FSimpleFader::Update does.
+		VectorStore(Elapsed, ElapsedTime);
+		VectorStore(VectorSelect(VectorCompareGE(Elapsed, Duration), Target, Current), CurrentVolume);
+	}
+}
+
+
+// =====================================================================================================================
+
+
+void FSimpleFaderBank::Add(const int32 FaderId, const FSimpleFader& Fader)
+{
+	check(FaderId >= 0);
+
+	Remove(FaderId);
+
+	if (!Fader.IsFading() || Fader.Envelope)
+	{
+		return;
+	}
+
+	if (!Slots.IsValidIndex(FaderId))
+	{
+		Slots.SetNum(FaderId + 1);
+	}
+
+	FLane& Lane = Lanes[static_cast<int32>(Fader.FadeCurve)];
+	Lane.StartVolume.Add(Fader.StartVolume);
+	Lane.TargetVolume.Add(Fader.TargetVolume);
+	Lane.FadeDuration.Add(Fader.FadeDuration);
+	Lane.ElapsedTime.Add(Fader.ElapsedTime);
+	Lane.CurrentVolume.Add(Fader.CurrentVolume);
+	Lane.OutputVolume.Add(Fader.GetVolume());
+	const int32 LaneIndex = Lane.FaderIds.Add(FaderId);
+
+	FFaderSlot& Slot = Slots[FaderId];
+	Slot.Lane = static_cast<int8>(Fader.FadeCurve);
+	Slot.LaneIndex = LaneIndex;
+}
+
+void FSimpleFaderBank::Remove(const int32 FaderId)
+{
+	if (!Contains(FaderId))
+	{
+		return;
+	}
+
+	FFaderSlot& Slot = Slots[FaderId];
+	FLane& Lane = Lanes[Slot.Lane];
+	const int32 LaneIndex = Slot.LaneIndex;
+
+	Lane.StartVolume.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.TargetVolume.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.FadeDuration.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.ElapsedTime.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.CurrentVolume.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.OutputVolume.RemoveAtSwap(LaneIndex, 1, false);
+	Lane.FaderIds.RemoveAtSwap(LaneIndex, 1, false);
+
+	if (Lane.FaderIds.IsValidIndex(LaneIndex))
+	{
+		Slots[Lane.FaderIds[LaneIndex]].LaneIndex = LaneIndex;
+	}
+
+	Slot.Lane = INDEX_NONE;
+	Slot.LaneIndex = INDEX_NONE;
+}
+
+void FSimpleFaderBank::Reset()
+{
+	for (FLane& Lane : Lanes)
+	{
+		Lane = FLane();
+	}
+
+	Slots.Reset();
+}
+
+bool FSimpleFaderBank::Contains(const int32 FaderId) const
+{
+	return Slots.IsValidIndex(FaderId) && Slots[FaderId].Lane != INDEX_NONE;
+}
+
+int32 FSimpleFaderBank::Num() const
+{
+	int32 NumFades = 0;
+	for (const FLane& Lane : Lanes)
+	{
+		NumFades += Lane.Num();
+	}
+	return NumFades;
+}
+
+
+// =====================================================================================================================
+
+
+void FSimpleFaderBank::Update(const float InDeltaTime)
+{
+	LastDeltaTime = InDeltaTime;
+
+	for (int32 CurveIndex = 0; CurveIndex < static_cast<int32>(Audio::EFaderCurve::Count); ++CurveIndex)
+	{
+		FLane& Lane = Lanes[CurveIndex];
+		if (Lane.Num() > 0)
+		{
+			UpdateLane(Lane, static_cast<Audio::EFaderCurve>(CurveIndex), InDeltaTime);
+		}
+	}
+}
+
+void FSimpleFaderBank::UpdateLane(FLane& Lane, const Audio::EFaderCurve InCurve, const float InDeltaTime)
+{
+	using namespace SimpleFaderBankPrivate;
+
+	const int32 Num = Lane.Num();
+	const int32 NumVectorized = Num - (Num % NumFloatsPerVector);
+	const VectorRegister DeltaTime = VectorSetFloat1(InDeltaTime);
+
+	const float* StartVolume = Lane.StartVolume.GetData();
+	const float* TargetVolume = Lane.TargetVolume.GetData();
+	const float* FadeDuration = Lane.FadeDuration.GetData();
+	float* ElapsedTime = Lane.ElapsedTime.GetData();
+	float* CurrentVolume = Lane.CurrentVolume.GetData();
+
+	for (int32 Index = 0; Index < NumVectorized; Index += NumFloatsPerVector)
+	{
+		UpdateVector(
+			StartVolume + Index, TargetVolume + Index, FadeDuration + Index, ElapsedTime + Index, CurrentVolume + Index,
+			DeltaTime
+		);
+	}
+
+	const int32 NumRemaining = Num - NumVectorized;
+	if (NumRemaining > 0)
+	{
+		// Pad the tail with finished dummy fades so it runs through the same kernel.
+		float TailStart[NumFloatsPerVector]    = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float TailTarget[NumFloatsPerVector]   = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float TailDuration[NumFloatsPerVector] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float TailElapsed[NumFloatsPerVector]  = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float TailCurrent[NumFloatsPerVector];
+
+		for (int32 Index = 0; Index < NumRemaining; ++Index)
+		{
+			TailStart[Index]    = StartVolume[NumVectorized + Index];
+			TailTarget[Index]   = TargetVolume[NumVectorized + Index];
+			TailDuration[Index] = FadeDuration[NumVectorized + Index];
+			TailElapsed[Index]  = ElapsedTime[NumVectorized + Index];
+		}
+
+		UpdateVector(TailStart, TailTarget, TailDuration, TailElapsed, TailCurrent, DeltaTime);
+
+		for (int32 Index = 0; Index < NumRemaining; ++Index)
+		{
+			ElapsedTime[NumVectorized + Index]   = TailElapsed[Index];
+			CurrentVolume[NumVectorized + Index] = TailCurrent[Index];
+		}
+	}
+
+	FSimpleFader::AlphaToVolume(Lane.CurrentVolume, Lane.OutputVolume, InCurve);
+}
+
+float FSimpleFaderBank::Sync(const int32 FaderId, FSimpleFader& Fader)
+{
+	check(Contains(FaderId));
+
+	const FFaderSlot& Slot = Slots[FaderId];
+	const FLane& Lane = Lanes[Slot.Lane];
+	const int32 LaneIndex = Slot.LaneIndex;
+
+	Fader.ElapsedTime = Lane.ElapsedTime[LaneIndex];
+	Fader.CurrentVolume = Lane.CurrentVolume[LaneIndex];
+
+	const bool bExpired = Lane.FadeDuration[LaneIndex] <= Lane.ElapsedTime[LaneIndex];
+	const bool bReachedTarget = LastDeltaTime > SMALL_NUMBER && FMath::IsNearlyEqual(Lane.CurrentVolume[LaneIndex], Lane.TargetVolume[LaneIndex]);
+	if (!bExpired && !bReachedTarget)
+	{
+		return Lane.OutputVolume[LaneIndex];
+	}
+
+	Fader.StopFade();
+	Remove(FaderId);
+	return Fader.GetVolume();
+}
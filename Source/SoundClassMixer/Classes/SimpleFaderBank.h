@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include "SimpleFader.h"
+
+/**
+ * Structure-of-arrays storage for the running fades of many FSimpleFaders.
+ * Fades live in contiguous float arrays grouped by curve type and are advanced together with
+ * VectorRegister (SSE/NEON) math, the curve applied through the batched AlphaToVolume.
+ * The faders themselves stay the source of truth: a fade is copied in when it starts and its
+ * progress is written back by Sync after every Update. Envelopes and idle faders aren't tracked.
+ * Results match FSimpleFader::Update within float rounding.
+ */
+class SOUNDCLASSMIXER_API FSimpleFaderBank
+{
+public:
+	/**
+	 * Tracks the fader's single segment fade under the given id, replacing whatever the id tracked before.
+	 * Idle faders and envelopes are only removed.
+	 */
+	void Add(int32 FaderId, const FSimpleFader& Fader);
+
+	/**
+	 * Stops tracking the id, the fader is left as of the last Sync.
+	 */
+	void Remove(int32 FaderId);
+
+	/**
+	 * Removes every fade.
+	 */
+	void Reset();
+
+	/**
+	 * Returns whether the id has a fade in the bank.
+	 */
+	bool Contains(int32 FaderId) const;
+
+	/**
+	 * Returns the number of fades in the bank.
+	 */
+	int32 Num() const;
+
+	/**
+	 * Advances every fade by the given delta in time since last update.
+	 */
+	void Update(float InDeltaTime);
+
+	/**
+	 * Copies the fade's progress into the fader and returns its volume, as FSimpleFader::Update followed by
+	 * GetVolume would. A finished fade is stopped on the fader and removed from the bank.
+	 */
+	float Sync(int32 FaderId, FSimpleFader& Fader);
+
+private:
+	/** Fades sharing one curve type. */
+	struct FLane
+	{
+		/** Same meaning as FSimpleFader's members (dB for the logarithmic lane). */
+		TArray<float> StartVolume;
+		TArray<float> TargetVolume;
+		TArray<float> FadeDuration;
+		TArray<float> ElapsedTime;
+		TArray<float> CurrentVolume;
+
+		/** Curve-applied volume, refreshed by Update. */
+		TArray<float> OutputVolume;
+
+		/** Owning fader id per lane entry. */
+		TArray<int32> FaderIds;
+
+		int32 Num() const { return FaderIds.Num(); }
+	};
+
+	struct FFaderSlot
+	{
+		/** Lane index (curve), INDEX_NONE when the id isn't tracked. */
+		int8 Lane = INDEX_NONE;
+
+		int32 LaneIndex = INDEX_NONE;
+	};
+
+	/** Vectorized closed form of one lane, curve applied into OutputVolume. */
+	static void UpdateLane(FLane& Lane, Audio::EFaderCurve InCurve, float InDeltaTime);
+
+	FLane Lanes[static_cast<int32>(Audio::EFaderCurve::Count)];
+
+	/** Indexed by fader id, grown on demand. */
+	TArray<FFaderSlot> Slots;
+
+	/** Delta of the last Update, for the same early stop as FSimpleFader::Update. */
+	float LastDeltaTime = 0.0f;
+};
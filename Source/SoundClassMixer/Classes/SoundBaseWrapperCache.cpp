@@ -0,0 +1,155 @@
+﻿#include "SoundBaseWrapperCache.h"
+
+#include "SoundClassMixerSettings.h"
+#include "SoundClassMixerSubsystem.h"
+#include "USoundBaseWrapper.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Wrapper Cache Hits"), STAT_SoundClassMixerWrapperCacheHits, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Wrapper Cache Misses"), STAT_SoundClassMixerWrapperCacheMisses, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Wrappers"), STAT_SoundClassMixerLiveWrappers, STATGROUP_SoundClassMixer);
+
+TUniquePtr<FSoundBaseWrapperCache> FSoundBaseWrapperCache::Instance;
+
+
+FSoundBaseWrapperCache::FSoundBaseWrapperCache()
+{
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FSoundBaseWrapperCache::OnPostGarbageCollect);
+
+#if WITH_EDITOR
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FSoundBaseWrapperCache::OnObjectPropertyChanged);
+#endif
+}
+
+FSoundBaseWrapperCache::~FSoundBaseWrapperCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+}
+
+FSoundBaseWrapperCache& FSoundBaseWrapperCache::Get()
+{
+	check(IsInGameThread());
+
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FSoundBaseWrapperCache>();
+	}
+	return *Instance;
+}
+
+void FSoundBaseWrapperCache::Shutdown()
+{
+	Instance.Reset();
+}
+
+USoundBaseWrapper* FSoundBaseWrapperCache::FindOrAdd(USoundBase* Sound, USoundSubmixBase* SubmixOverride)
+{
+	check(IsInGameThread());
+	check(Sound);
+
+	const int32 MaxEntries = GetDefault<USoundClassMixerSettings>()->WrapperCacheSize;
+
+	const FKey Key(Sound, SubmixOverride);
+	FEntry* Entry = Entries.Find(Key);
+
+	// Collected once nothing played it across a GC; a fresh wrapper replaces it below.
+	if (USoundBaseWrapper* CachedWrapper = Entry ? Entry->Wrapper.Get() : nullptr)
+	{
+		INC_DWORD_STAT(STAT_SoundClassMixerWrapperCacheHits);
+		Entry->LastUsed = ++UseCounter;
+		return CachedWrapper;
+	}
+
+	INC_DWORD_STAT(STAT_SoundClassMixerWrapperCacheMisses);
+
+	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
+	Wrapper->InheritSoundBase(Sound);
+	Wrapper->SoundSubmixOverride = SubmixOverride;
+
+	// Caching disabled: the wrapper is owned by whatever plays it, as before.
+	if (MaxEntries <= 0)
+	{
+		return Wrapper;
+	}
+
+	if (!Entry)
+	{
+		while (Entries.Num() >= MaxEntries)
+		{
+			EvictLeastRecentlyUsed();
+		}
+		Entry = &Entries.Add(Key);
+	}
+
+	Entry->Wrapper  = Wrapper;
+	Entry->LastUsed = ++UseCounter;
+
+	SET_DWORD_STAT(STAT_SoundClassMixerLiveWrappers, Entries.Num());
+	return Wrapper;
+}
+
+void FSoundBaseWrapperCache::Empty()
+{
+	Entries.Empty();
+	SET_DWORD_STAT(STAT_SoundClassMixerLiveWrappers, 0);
+}
+
+void FSoundBaseWrapperCache::EvictLeastRecentlyUsed()
+{
+	// Linear scan; only runs on a miss with a full cache, and the cache is small.
+	const FKey* OldestKey = nullptr;
+	uint64 OldestUse = MAX_uint64;
+	for (const TPair<FKey, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.LastUsed < OldestUse)
+		{
+			OldestUse = Pair.Value.LastUsed;
+			OldestKey = &Pair.Key;
+		}
+	}
+
+	if (OldestKey)
+	{
+		// Sounds still playing the evicted wrapper keep it alive through their own references.
+		const FKey KeyToRemove = *OldestKey;
+		Entries.Remove(KeyToRemove);
+	}
+}
+
+void FSoundBaseWrapperCache::OnPostGarbageCollect()
+{
+	for (TMap<FKey, FEntry>::TIterator It = Entries.CreateIterator(); It; ++It)
+	{
+		// A null submix override is a valid key, only a collected one is stale.
+		const bool bSubmixCollected = !It.Key().Value.IsExplicitlyNull() && !It.Key().Value.IsValid();
+		if (!It.Value().Wrapper.IsValid() || !It.Key().Key.IsValid() || bSubmixCollected)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	SET_DWORD_STAT(STAT_SoundClassMixerLiveWrappers, Entries.Num());
+}
+
+#if WITH_EDITOR
+void FSoundBaseWrapperCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (!Object || !Object->IsA<USoundBase>() || Object->IsA<USoundBaseWrapper>())
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<USoundBase> SoundKey(static_cast<USoundBase*>(Object));
+	for (TMap<FKey, FEntry>::TIterator It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == SoundKey)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	SET_DWORD_STAT(STAT_SoundClassMixerLiveWrappers, Entries.Num());
+}
+#endif
@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class USoundBase;
+class USoundBaseWrapper;
+class USoundSubmixBase;
+struct FPropertyChangedEvent;
+
+
+/**
+ * Reuses one USoundBaseWrapper per (InnerSound, SubmixOverride) pair for the *_WithSubmixOverride nodes,
+ * instead of creating and filling a new transient wrapper for every play call.
+ * Bounded by USoundClassMixerSettings::WrapperCacheSize, the least recently used wrapper is dropped first.
+ * Entries are weak: whatever plays a wrapper keeps it (and its InnerSound) alive, the cache never does.
+ * A wrapper nobody references is collected at the next GC, after which its entry is dropped along with
+ * entries whose sound or submix was collected.
+ * Game thread only.
+ */
+class SOUNDCLASSMIXER_API FSoundBaseWrapperCache
+{
+public:
+	FSoundBaseWrapperCache();
+	~FSoundBaseWrapperCache();
+
+	static FSoundBaseWrapperCache& Get();
+	static void Shutdown();
+
+	/** Cached wrapper for the pair, or a new one. Never null for a valid Sound. */
+	USoundBaseWrapper* FindOrAdd(USoundBase* Sound, USoundSubmixBase* SubmixOverride);
+
+	void Empty();
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	using FKey = TPair<TWeakObjectPtr<USoundBase>, TWeakObjectPtr<USoundSubmixBase>>;
+
+	struct FEntry
+	{
+		TWeakObjectPtr<USoundBaseWrapper> Wrapper;
+		uint64 LastUsed = 0;
+	};
+
+	void EvictLeastRecentlyUsed();
+
+	/** Drops the entries whose wrapper, sound or submix was collected. */
+	void OnPostGarbageCollect();
+
+	FDelegateHandle PostGarbageCollectHandle;
+
+#if WITH_EDITOR
+	/**
+	 * Drops the wrappers of an edited sound so the next play copies it into a fresh one.
+	 * Wrappers already handed out are never modified, active sounds may be reading them on the audio thread.
+	 */
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+	TMap<FKey, FEntry> Entries;
+	uint64 UseCounter = 0;
+
+	static TUniquePtr<FSoundBaseWrapperCache> Instance;
+};
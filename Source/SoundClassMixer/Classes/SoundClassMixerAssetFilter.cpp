@@ -0,0 +1,245 @@
+﻿#include "SoundClassMixerAssetFilter.h"
+
+#include "AssetData.h"
+#include "SoundClassMixerSettings.h"
+#include "Misc/StringBuilder.h"
+#include "Sound/SoundClass.h"
+#include "Sound/SoundSubmix.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogSoundClassMixerAssetFilter, Log, All);
+
+
+namespace SoundClassMixerAssetFilterPrivate
+{
+	bool MatchesSegmentPrefix(const TArray<FString>& SegmentPrefixes, const TCHAR* Segment, const int32 SegmentLen)
+	{
+		for (const FString& SegmentPrefix : SegmentPrefixes)
+		{
+			// Case insensitive like the FName lookup.
+			if (SegmentPrefix.Len() <= SegmentLen && FCString::Strnicmp(Segment, *SegmentPrefix, SegmentPrefix.Len()) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+
+FSoundClassMixerPathTrie::FSoundClassMixerPathTrie()
+{
+	Nodes.AddDefaulted();
+}
+
+void FSoundClassMixerPathTrie::Add(const FString& PathPrefix)
+{
+	Nodes[FindOrAddNode(PathPrefix)].bTerminal = true;
+}
+
+void FSoundClassMixerPathTrie::AddSegmentPrefix(const FString& ParentPath, const FString& SegmentPrefix)
+{
+	Nodes[FindOrAddNode(ParentPath)].SegmentPrefixes.AddUnique(SegmentPrefix);
+}
+
+int32 FSoundClassMixerPathTrie::FindOrAddNode(const FString& Path)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"), true);
+
+	int32 NodeIndex = 0;
+	for (const FString& Segment : Segments)
+	{
+		const FName SegmentName(*Segment);
+		if (const int32* ChildIndex = Nodes[NodeIndex].Children.Find(SegmentName))
+		{
+			NodeIndex = *ChildIndex;
+			continue;
+		}
+
+		const int32 NewNodeIndex = Nodes.AddDefaulted();
+		Nodes[NodeIndex].Children.Add(SegmentName, NewNodeIndex);
+		NodeIndex = NewNodeIndex;
+	}
+
+	return NodeIndex;
+}
+
+bool FSoundClassMixerPathTrie::Matches(const FName PackagePath) const
+{
+	const FNode* Node = &Nodes[0];
+	if (Node->bTerminal)
+	{
+		return true;
+	}
+
+	if (Node->Children.Num() == 0 && Node->SegmentPrefixes.Num() == 0)
+	{
+		return false;
+	}
+
+	TStringBuilder<256> PathBuilder;
+	PackagePath.AppendString(PathBuilder);
+
+	const TCHAR* Path = PathBuilder.ToString();
+	const int32 PathLen = PathBuilder.Len();
+
+	int32 SegmentStart = 0;
+	while (SegmentStart < PathLen)
+	{
+		int32 SegmentEnd = SegmentStart;
+		while (SegmentEnd < PathLen && Path[SegmentEnd] != TEXT('/'))
+		{
+			++SegmentEnd;
+		}
+
+		if (SegmentEnd > SegmentStart)
+		{
+			if (Node->SegmentPrefixes.Num() > 0
+				&& SoundClassMixerAssetFilterPrivate::MatchesSegmentPrefix(Node->SegmentPrefixes, Path + SegmentStart, SegmentEnd - SegmentStart))
+			{
+				return true;
+			}
+
+			// FNAME_Find: a segment no rule mentions can't be in the trie.
+			const FName SegmentName(SegmentEnd - SegmentStart, Path + SegmentStart, FNAME_Find);
+			const int32* ChildIndex = SegmentName.IsNone() ? nullptr : Node->Children.Find(SegmentName);
+			if (!ChildIndex)
+			{
+				return false;
+			}
+
+			Node = &Nodes[*ChildIndex];
+			if (Node->bTerminal)
+			{
+				return true;
+			}
+		}
+
+		SegmentStart = SegmentEnd + 1;
+	}
+
+	return false;
+}
+
+
+// =====================================================================================================================
+
+
+void FSoundClassMixerAssetRules::Build(
+	const TArray<FString>& ExcludedNames,
+	const TArray<FSoftObjectPath>& ExcludedAssets,
+	const TArray<FString>& ExcludedPaths,
+	const TArray<FString>& IncludedPaths
+)
+{
+	*this = FSoundClassMixerAssetRules();
+
+	for (const FString& Name : ExcludedNames)
+	{
+		ExcludedAssetNames.Add(FName(*Name));
+	}
+
+	for (const FSoftObjectPath& AssetPath : ExcludedAssets)
+	{
+		if (AssetPath.IsValid())
+		{
+			ExcludedObjectPaths.Add(AssetPath.GetAssetPathName());
+		}
+	}
+
+	for (const FString& PathRule : ExcludedPaths)
+	{
+		AddPathRule(PathRule, ExcludedPrefixes, ExcludedPackages);
+	}
+
+	for (const FString& PathRule : IncludedPaths)
+	{
+		AddPathRule(PathRule, IncludedPrefixes, IncludedPackages);
+		bHasInclusionRules = true;
+	}
+}
+
+bool FSoundClassMixerAssetRules::IsIncluded(const FAssetData& AssetData) const
+{
+	if (bHasInclusionRules
+		&& !IncludedPackages.Contains(AssetData.PackageName)
+		&& !IncludedPrefixes.Matches(AssetData.PackagePath))
+	{
+		return false;
+	}
+
+	if (ExcludedAssetNames.Contains(AssetData.AssetName)
+		|| ExcludedObjectPaths.Contains(AssetData.ObjectPath)
+		|| ExcludedPackages.Contains(AssetData.PackageName))
+	{
+		return false;
+	}
+
+	return !ExcludedPrefixes.Matches(AssetData.PackagePath);
+}
+
+void FSoundClassMixerAssetRules::AddPathRule(const FString& PathRule, FSoundClassMixerPathTrie& Prefixes, TSet<FName>& Packages)
+{
+	FString Rule = PathRule.TrimStartAndEnd();
+	if (Rule.IsEmpty())
+	{
+		return;
+	}
+
+	int32 WildcardIndex = INDEX_NONE;
+	if (Rule.FindChar(TEXT('*'), WildcardIndex))
+	{
+		if (WildcardIndex != Rule.Len() - 1)
+		{
+			UE_LOG(LogSoundClassMixerAssetFilter, Warning, TEXT("Ignoring path rule \"%s\": \"*\" is only supported at the end of the rule."), *PathRule);
+			return;
+		}
+
+		Rule.LeftChopInline(1, false);
+
+		// "/Game/Legacy/*" is the folder itself, "/Game/Legacy/Aud*" any folder in it starting with "Aud".
+		int32 SlashIndex = INDEX_NONE;
+		Rule.FindLastChar(TEXT('/'), SlashIndex);
+		const FString SegmentPrefix = Rule.Mid(SlashIndex + 1);
+		if (SegmentPrefix.IsEmpty())
+		{
+			Prefixes.Add(Rule);
+		}
+		else
+		{
+			Prefixes.AddSegmentPrefix(Rule.Left(FMath::Max(SlashIndex, 0)), SegmentPrefix);
+		}
+		return;
+	}
+
+	// "/Game/Audio/SC_Music.SC_Music" and "/Game/Audio/SC_Music" both name the package.
+	FString PackageName;
+	if (Rule.Split(TEXT("."), &PackageName, nullptr))
+	{
+		Rule = PackageName;
+	}
+	Packages.Add(FName(*Rule));
+}
+
+
+// =====================================================================================================================
+
+
+FSoundClassMixerAssetFilter::FSoundClassMixerAssetFilter(const USoundClassMixerSettings& Settings)
+{
+	TArray<FSoftObjectPath> ExcludedSoundClasses;
+	for (const TSoftObjectPtr<USoundClass>& SoundClass : Settings.ExcludedSoundClasses)
+	{
+		ExcludedSoundClasses.Add(SoundClass.ToSoftObjectPath());
+	}
+
+	TArray<FSoftObjectPath> ExcludedSoundSubmixes;
+	for (const TSoftObjectPtr<USoundSubmix>& SoundSubmix : Settings.ExcludedSoundSubmixes)
+	{
+		ExcludedSoundSubmixes.Add(SoundSubmix.ToSoftObjectPath());
+	}
+
+	SoundClassRules.Build(Settings.ExcludedSoundClassNames, ExcludedSoundClasses, Settings.ExcludedSoundClassPaths, {});
+	SoundSubmixRules.Build(Settings.ExcludedSoundSubmixNames, ExcludedSoundSubmixes, Settings.ExcludedSoundSubmixPaths, Settings.IncludedSoundSubmixPaths);
+}
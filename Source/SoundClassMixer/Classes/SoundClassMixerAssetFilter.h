@@ -0,0 +1,87 @@
+﻿#pragma once
+
+#include "UObject/SoftObjectPath.h"
+
+class USoundClassMixerSettings;
+struct FAssetData;
+
+/**
+ * Package path prefix trie, one node per path segment ("/Game/Legacy/Audio" -> Game, Legacy, Audio).
+ * Lookup cost depends on path depth only, not on the number of rules.
+ */
+class SOUNDCLASSMIXER_API FSoundClassMixerPathTrie
+{
+public:
+	FSoundClassMixerPathTrie();
+
+	/** Everything at or below PathPrefix matches. */
+	void Add(const FString& PathPrefix);
+
+	/** Every folder directly under ParentPath whose name starts with SegmentPrefix matches, with everything below it. */
+	void AddSegmentPrefix(const FString& ParentPath, const FString& SegmentPrefix);
+
+	/** Whether any added prefix contains the given package path. */
+	bool Matches(FName PackagePath) const;
+
+private:
+	struct FNode
+	{
+		TMap<FName, int32> Children;
+
+		/** Checked linearly before the exact lookup, there are rarely more than a few. */
+		TArray<FString> SegmentPrefixes;
+
+		bool bTerminal = false;
+	};
+
+	/** Returns the node for Path, adding the missing ones. */
+	int32 FindOrAddNode(const FString& Path);
+
+	TArray<FNode> Nodes;
+};
+
+/**
+ * Inclusion/exclusion rules for one asset type, compiled from USoundClassMixerSettings.
+ * Path rules ending in "*" match whole folders ("/Game/Legacy/Audio/*") or every folder whose
+ * name starts with the last segment ("/Game/Legacy/Aud*"), other path rules match a single package.
+ * A "*" anywhere else is not supported; such rules are logged and ignored.
+ */
+class SOUNDCLASSMIXER_API FSoundClassMixerAssetRules
+{
+public:
+	void Build(
+		const TArray<FString>& ExcludedNames,
+		const TArray<FSoftObjectPath>& ExcludedAssets,
+		const TArray<FString>& ExcludedPaths,
+		const TArray<FString>& IncludedPaths
+	);
+
+	bool IsIncluded(const FAssetData& AssetData) const;
+
+private:
+	static void AddPathRule(const FString& PathRule, FSoundClassMixerPathTrie& Prefixes, TSet<FName>& Packages);
+
+	TSet<FName> ExcludedAssetNames;
+	TSet<FName> ExcludedObjectPaths;
+	TSet<FName> ExcludedPackages;
+	FSoundClassMixerPathTrie ExcludedPrefixes;
+
+	/** When any inclusion rule exists, assets outside of them are excluded. */
+	TSet<FName> IncludedPackages;
+	FSoundClassMixerPathTrie IncludedPrefixes;
+	bool bHasInclusionRules = false;
+};
+
+/** Compiled SoundClass and SoundSubmix filters, see USoundClassMixerSettings::GetAssetFilter. */
+class SOUNDCLASSMIXER_API FSoundClassMixerAssetFilter
+{
+public:
+	explicit FSoundClassMixerAssetFilter(const USoundClassMixerSettings& Settings);
+
+	bool IsSoundClassIncluded(const FAssetData& AssetData) const { return SoundClassRules.IsIncluded(AssetData); }
+	bool IsSoundSubmixIncluded(const FAssetData& AssetData) const { return SoundSubmixRules.IsIncluded(AssetData); }
+
+private:
+	FSoundClassMixerAssetRules SoundClassRules;
+	FSoundClassMixerAssetRules SoundSubmixRules;
+};
@@ -0,0 +1,68 @@
+﻿#include "SoundClassMixerLatencyHistogram.h"
+
+
+FSoundClassMixerLatencyHistogram::FSoundClassMixerLatencyHistogram()
+{
+	Reset();
+}
+
+void FSoundClassMixerLatencyHistogram::Add(const float LatencyMs)
+{
+	// Bucket i holds (Upper(i - 1), Upper(i)], everything at or below MinLatencyMs lands in bucket 0.
+	const float Octaves = FMath::Log2(FMath::Max(LatencyMs, MinLatencyMs) / MinLatencyMs);
+	const int32 BucketIndex = FMath::Clamp(FMath::CeilToInt(Octaves * BucketsPerOctave), 0, NumBuckets - 1);
+
+	Buckets[BucketIndex].fetch_add(1, std::memory_order_relaxed);
+	NumSamples.fetch_add(1, std::memory_order_relaxed);
+
+	// Single writer, a plain compare is enough.
+	if (LatencyMs > MaxLatencyMs.load(std::memory_order_relaxed))
+	{
+		MaxLatencyMs.store(LatencyMs, std::memory_order_relaxed);
+	}
+}
+
+float FSoundClassMixerLatencyHistogram::GetPercentile(const float Percentile) const
+{
+	uint32 Counts[NumBuckets];
+	uint64 Total = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Counts[BucketIndex] = Buckets[BucketIndex].load(std::memory_order_relaxed);
+		Total += Counts[BucketIndex];
+	}
+
+	if (Total == 0)
+	{
+		return 0.0f;
+	}
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0f, 1.0f) * Total)));
+
+	uint64 Seen = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Seen += Counts[BucketIndex];
+		if (Seen >= Rank)
+		{
+			return FMath::Min(GetBucketUpperBound(BucketIndex), GetMax());
+		}
+	}
+
+	return GetMax();
+}
+
+void FSoundClassMixerLatencyHistogram::Reset()
+{
+	for (std::atomic<uint32>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	NumSamples.store(0, std::memory_order_relaxed);
+	MaxLatencyMs.store(0.0f, std::memory_order_relaxed);
+}
+
+float FSoundClassMixerLatencyHistogram::GetBucketUpperBound(const int32 BucketIndex)
+{
+	return MinLatencyMs * FMath::Pow(2.0f, static_cast<float>(BucketIndex) / BucketsPerOctave);
+}
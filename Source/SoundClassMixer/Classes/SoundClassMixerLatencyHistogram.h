@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Log-spaced latency histogram, four buckets per octave from 0.01 ms up to ~8.6 s.
+ * One writer (the audio thread), any number of readers; percentiles report the bucket's
+ * upper bound, so they overestimate by at most 19%.
+ */
+class SOUNDCLASSMIXER_API FSoundClassMixerLatencyHistogram
+{
+public:
+	FSoundClassMixerLatencyHistogram();
+
+	void Add(float LatencyMs);
+
+	/** Percentile in [0, 1], 0 when empty. */
+	float GetPercentile(float Percentile) const;
+
+	float GetMax() const { return MaxLatencyMs.load(std::memory_order_relaxed); }
+	uint32 GetNumSamples() const { return NumSamples.load(std::memory_order_relaxed); }
+
+	/** Samples added concurrently with a reset may survive it. */
+	void Reset();
+
+private:
+	static constexpr int32 NumBuckets = 80;
+	static constexpr int32 BucketsPerOctave = 4;
+	static constexpr float MinLatencyMs = 0.01f;
+
+	static float GetBucketUpperBound(int32 BucketIndex);
+
+	std::atomic<uint32> Buckets[NumBuckets];
+	std::atomic<uint32> NumSamples { 0 };
+	std::atomic<float> MaxLatencyMs { 0.0f };
+};
@@ -0,0 +1,77 @@
+﻿#include "SoundClassMixerManifest.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SoundClassMixerManifestPrivate
+{
+	constexpr uint32 Magic = 0x53434D4D; // "SCMM"
+	constexpr int32 Version = 2;
+}
+
+
+FArchive& operator<<(FArchive& Ar, FSoundClassMixerManifestEntry& Entry)
+{
+	FString PathString = Entry.Path.ToString();
+	Ar << PathString;
+	Ar << Entry.DefaultVolume;
+
+	if (Ar.IsLoading())
+	{
+		Entry.Path.SetPath(PathString);
+	}
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FSoundClassMixerManifest& Manifest)
+{
+	uint32 Magic = SoundClassMixerManifestPrivate::Magic;
+	int32 Version = SoundClassMixerManifestPrivate::Version;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Magic != SoundClassMixerManifestPrivate::Magic || Version != SoundClassMixerManifestPrivate::Version)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Manifest.AssetFilterHash;
+	Ar << Manifest.SoundClasses;
+	Ar << Manifest.SoundSubmixes;
+	return Ar;
+}
+
+
+// =====================================================================================================================
+
+
+FString FSoundClassMixerManifest::GetDefaultFilename()
+{
+	return FPaths::ProjectContentDir() / TEXT("SoundClassMixer") / TEXT("SoundClassMixerManifest.bin");
+}
+
+bool FSoundClassMixerManifest::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	Reader << *this;
+	return !Reader.IsError();
+}
+
+bool FSoundClassMixerManifest::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Writer << const_cast<FSoundClassMixerManifest&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
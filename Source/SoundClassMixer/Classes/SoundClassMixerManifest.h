@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include "UObject/SoftObjectPath.h"
+
+/** One gathered SoundClass/SoundSubmix as written by the manifest commandlet. */
+struct FSoundClassMixerManifestEntry
+{
+	FSoftObjectPath Path;
+
+	/** Properties.Volume / OutputVolume at cook time; the channel's initial volume when gathered from the manifest. */
+	float DefaultVolume = 1.0f;
+
+	friend FArchive& operator<<(FArchive& Ar, FSoundClassMixerManifestEntry& Entry);
+};
+
+/**
+ * Pre-filtered list of the SoundClasses and SoundSubmixes the mixer manages.
+ * Written at cook time by the SoundClassMixerManifest commandlet so cooked builds
+ * can skip the asset registry scan in USoundClassMixerSubsystem::GatherSoundClasses.
+ *
+ * Re-running the commandlet is part of packaging: the manifest isn't rebuilt by the cook. Cooked builds only
+ * detect a changed filter (AssetFilterHash) and entries that no longer load; assets added since it was written,
+ * or authored volumes changed since, go unnoticed.
+ */
+struct SOUNDCLASSMIXER_API FSoundClassMixerManifest
+{
+	TArray<FSoundClassMixerManifestEntry> SoundClasses;
+	TArray<FSoundClassMixerManifestEntry> SoundSubmixes;
+
+	/** USoundClassMixerSettings::GetAssetFilterHash when written; a mismatch falls back to the asset registry scan. */
+	uint32 AssetFilterHash = 0;
+
+	/** Location the commandlet writes to and cooked builds read from, staged through the module's RuntimeDependencies. */
+	static FString GetDefaultFilename();
+
+	bool LoadFromFile(const FString& Filename);
+	bool SaveToFile(const FString& Filename) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FSoundClassMixerManifest& Manifest);
+};
@@ -4,3 +4,53 @@ USoundClassMixerSettings::USoundClassMixerSettings()
 {
 	CategoryName = TEXT("Sound Class Mixer");
 }
+
+const FSoundClassMixerAssetFilter& USoundClassMixerSettings::GetAssetFilter() const
+{
+	if (!AssetFilter.IsValid())
+	{
+		AssetFilter = MakeUnique<FSoundClassMixerAssetFilter>(*this);
+	}
+	return *AssetFilter;
+}
+
+uint32 USoundClassMixerSettings::GetAssetFilterHash() const
+{
+	uint32 Hash = 0;
+
+	// Counts are mixed in so a rule moving between lists changes the hash.
+	auto HashRules = [&Hash](const TArray<FString>& Rules)
+	{
+		Hash = HashCombine(Hash, static_cast<uint32>(Rules.Num()));
+		for (const FString& Rule : Rules)
+		{
+			Hash = FCrc::StrCrc32(*Rule, Hash);
+		}
+	};
+	auto HashAssets = [&Hash](const auto& Assets)
+	{
+		Hash = HashCombine(Hash, static_cast<uint32>(Assets.Num()));
+		for (const auto& Asset : Assets)
+		{
+			Hash = FCrc::StrCrc32(*Asset.ToString(), Hash);
+		}
+	};
+
+	HashRules(ExcludedSoundClassNames);
+	HashAssets(ExcludedSoundClasses);
+	HashRules(ExcludedSoundClassPaths);
+	HashRules(IncludedSoundSubmixPaths);
+	HashRules(ExcludedSoundSubmixNames);
+	HashAssets(ExcludedSoundSubmixes);
+	HashRules(ExcludedSoundSubmixPaths);
+	return Hash;
+}
+
+#if WITH_EDITOR
+void USoundClassMixerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	AssetFilter.Reset();
+}
+#endif
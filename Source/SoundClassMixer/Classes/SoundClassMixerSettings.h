@@ -1,9 +1,43 @@
 ﻿#pragma once
 
 #include "UObject/Object.h"
+#include "SoundClassMixerAssetFilter.h"
 
 #include "SoundClassMixerSettings.generated.h"
 
+class USoundClass;
+class USoundSubmix;
+
+/** How overlapping duck requests on the same SoundClass are resolved. */
+UENUM()
+enum class ESoundClassMixerDuckPolicy : uint8
+{
+	/** The strongest attenuation wins. */
+	Deepest,
+
+	/** The weakest attenuation wins. */
+	Shallowest,
+
+	/** The highest priority request wins, ties go to the strongest attenuation. */
+	Priority
+};
+
+/** How the *_WithSubmixOverride play/spawn nodes reroute a sound. */
+UENUM()
+enum class ESoundClassMixerSubmixOverrideMode : uint8
+{
+	/** Play a USoundBaseWrapper whose GetSoundSubmix() returns the override. Replaces the base submix. */
+	Wrapper,
+
+	/**
+	 * Play the original sound with its base submix output turned off and a full level submix send to
+	 * the override; no wrapper object. One-shots (PlaySound*) queue the active sound directly, without
+	 * an audio component. Spawned components are rerouted until their sound stops; later Play calls on them
+	 * play without the override.
+	 */
+	SubmixSend
+};
+
 /**
  * Settings for SoundClassMixer Subsystem.
  */
@@ -13,6 +47,16 @@ class SOUNDCLASSMIXER_API USoundClassMixerSettings : public UDeveloperSettings
 	GENERATED_BODY()
 public:
 	USoundClassMixerSettings();
+
+	/** Filtering rules compiled into hash sets and path tries; built on first use. */
+	const FSoundClassMixerAssetFilter& GetAssetFilter() const;
+
+	/** Stable across runs; stored in the manifest so cooked builds notice filter changes made since it was written. */
+	uint32 GetAssetFilterHash() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 	
 public:
 	UPROPERTY(Config, EditAnywhere, Category = "Filtering")
@@ -20,4 +64,82 @@ public:
 	
 	UPROPERTY(Config, EditAnywhere, Category = "Filtering")
 		TArray<TSoftObjectPtr<USoundClass>> ExcludedSoundClasses;
+
+	/**
+	 * Package paths to exclude, "/Game/Legacy/Audio/*" excludes a folder and everything below it,
+	 * "/Game/Legacy/Aud*" every folder in /Game/Legacy whose name starts with "Aud".
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering")
+		TArray<FString> ExcludedSoundClassPaths;
+
+	/** When not empty, only SoundSubmixes under these package paths are managed ("/Game/Audio/Submixes/*"). */
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering|Submixes")
+		TArray<FString> IncludedSoundSubmixPaths;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering|Submixes")
+		TArray<FString> ExcludedSoundSubmixNames;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering|Submixes")
+		TArray<TSoftObjectPtr<USoundSubmix>> ExcludedSoundSubmixes;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering|Submixes")
+		TArray<FString> ExcludedSoundSubmixPaths;
+
+	/** Stream SoundClasses/SoundSubmixes in after startup instead of loading them synchronously in Initialize. */
+	UPROPERTY(Config, EditAnywhere, Category = "Loading")
+		bool bAsyncGather = false;
+
+	/** Number of assets per async load request. */
+	UPROPERTY(Config, EditAnywhere, Category = "Loading", meta = (EditCondition = "bAsyncGather", ClampMin = "1"))
+		int32 AsyncLoadBatchSize = 32;
+
+	/**
+	 * Run submix fades on the audio render thread through a submix effect, ramping gain per buffer.
+	 * Fade timing then follows the audio clock. The channel fader is no longer advanced each update while the
+	 * effect runs the fade; volume queries read the gain the effect last rendered. Ducks and sidechains still update
+	 * on the audio thread and go to the device stage.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Submixes")
+		bool bRenderThreadSubmixFades = false;
+
+	/**
+	 * Mid-fade submix gains closer than this to the last one sent to the audio device are not sent again.
+	 * The final value of a fade is always sent exactly.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Submixes", meta = (ClampMin = "0.0"))
+		float SubmixVolumeEpsilon = 1.e-4f;
+
+	/**
+	 * Apply volumes to this game instance's audio device only, leaving the SoundClass/SoundSubmix assets untouched.
+	 * SoundClasses go through a per-device sound mix override, SoundSubmixes through the device's submix volume,
+	 * so split-screen and multi-client PIE sessions don't overwrite each other's mix.
+	 * The SubmixVolumeEpsilon filter then covers the SoundClass overrides as well. Volume queries and fade
+	 * directions read the channel's mixed volume, never the asset's authored one.
+	 * The override only scales a SoundClass's authored volume, so a class authored at 0 stays silent in this mode.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Devices")
+		bool bDeviceScopedVolumes = false;
+
+	/**
+	 * Wrappers kept for the *_WithSubmixOverride play/spawn nodes, one per (Sound, SubmixOverride) pair.
+	 * The least recently used one is dropped when full; 0 creates a new wrapper for every call.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Playback", meta = (ClampMin = "0"))
+		int32 WrapperCacheSize = 256;
+
+	/**
+	 * Advance faders in whole steps of this many seconds, carrying the remainder to the next update,
+	 * so fades land on the same step grid regardless of frame rate. 0 uses the frame's delta directly.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Fading", meta = (ClampMin = "0.0", Units = "s"))
+		float FaderFixedTimeStep = 0.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Ducking")
+		ESoundClassMixerDuckPolicy DuckPolicy = ESoundClassMixerDuckPolicy::Priority;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Playback")
+		ESoundClassMixerSubmixOverrideMode SubmixOverrideMode = ESoundClassMixerSubmixOverrideMode::Wrapper;
+
+private:
+	mutable TUniquePtr<FSoundClassMixerAssetFilter> AssetFilter;
 };
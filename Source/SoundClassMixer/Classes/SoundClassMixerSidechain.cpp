@@ -0,0 +1,47 @@
+﻿#include "SoundClassMixerSidechain.h"
+
+#include "DSP/Dsp.h"
+
+
+FSoundClassMixerSidechain::FSoundClassMixerSidechain(const FSoundClassMixerSidechainSettings& InSettings)
+	: ThresholdDb(InSettings.ThresholdDb)
+	, RangeDb(FMath::Max(0.1f, InSettings.RangeDb))
+	, MaxAttenuationDb(FMath::Max(0.0f, InSettings.MaxAttenuationDb))
+	, AttackTime(FMath::Max(0.0f, InSettings.AttackTime))
+	, ReleaseTime(FMath::Max(0.0f, InSettings.ReleaseTime))
+{
+}
+
+void FSoundClassMixerSidechain::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, const int32 NumSamples, const int32 NumChannels, const int32 SampleRate, double AudioClock)
+{
+	if (NumChannels <= 0 || SampleRate <= 0)
+	{
+		return;
+	}
+
+	// One-pole smoothing per frame, coefficients only change with the device sample rate.
+	if (SampleRate != CoefficientSampleRate)
+	{
+		CoefficientSampleRate = SampleRate;
+		AttackCoefficient  = AttackTime > 0.0f ? FMath::Exp(-1.0f / (AttackTime * SampleRate)) : 0.0f;
+		ReleaseCoefficient = ReleaseTime > 0.0f ? FMath::Exp(-1.0f / (ReleaseTime * SampleRate)) : 0.0f;
+	}
+
+	const int32 NumFrames = NumSamples / NumChannels;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		float Peak = 0.0f;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Peak = FMath::Max(Peak, FMath::Abs(AudioData[Frame * NumChannels + Channel]));
+		}
+
+		const float Coefficient = Peak > Envelope ? AttackCoefficient : ReleaseCoefficient;
+		Envelope = Coefficient * Envelope + (1.0f - Coefficient) * Peak;
+	}
+
+	const float EnvelopeDb = Audio::ConvertToDecibels(Envelope, KINDA_SMALL_NUMBER);
+	const float Amount = FMath::Clamp((EnvelopeDb - ThresholdDb) / RangeDb, 0.0f, 1.0f);
+	const float NewGain = Audio::ConvertToLinear(-MaxAttenuationDb * Amount);
+	Gain.store(NewGain, std::memory_order_relaxed);
+}
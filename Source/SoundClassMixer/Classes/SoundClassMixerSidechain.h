@@ -0,0 +1,78 @@
+﻿#pragma once
+
+#include "AudioDevice.h"
+
+#include <atomic>
+
+#include "SoundClassMixerSidechain.generated.h"
+
+class USoundClass;
+class USoundSubmix;
+
+
+/** Ducks targets by the loudness of a source submix, see USoundClassMixerSubsystem::AddSidechain. */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerSidechainSettings
+{
+	GENERATED_BODY()
+
+	/** Submix whose output is followed, e.g. Dialogue. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain)
+		USoundSubmix* SourceSubmix = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain)
+		TArray<USoundClass*> TargetClasses;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain)
+		TArray<USoundSubmix*> TargetSubmixes;
+
+	/** Envelope level where ducking starts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain, meta = (ClampMax = "0.0"))
+		float ThresholdDb = -40.0f;
+
+	/** How far above the threshold the envelope has to be for full attenuation. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain, meta = (ClampMin = "0.1"))
+		float RangeDb = 12.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain, meta = (ClampMin = "0.0"))
+		float MaxAttenuationDb = 12.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain, meta = (ClampMin = "0.0"))
+		float AttackTime = 0.01f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Sidechain, meta = (ClampMin = "0.0"))
+		float ReleaseTime = 0.3f;
+};
+
+
+/**
+ * Peak envelope follower on a submix's output, run on the audio render thread for every buffer.
+ * The resulting duck gain is only published through an atomic, the mixer polls it from its audio thread update.
+ */
+class SOUNDCLASSMIXER_API FSoundClassMixerSidechain : public ISubmixBufferListener
+{
+public:
+	explicit FSoundClassMixerSidechain(const FSoundClassMixerSidechainSettings& InSettings);
+
+	//~ Begin ISubmixBufferListener
+	virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override;
+	//~ End ISubmixBufferListener
+
+	/** Duck gain for the targets, 1 while the source is below the threshold. Any thread. */
+	float GetGain() const { return Gain.load(std::memory_order_relaxed); }
+
+private:
+	float ThresholdDb;
+	float RangeDb;
+	float MaxAttenuationDb;
+	float AttackTime;
+	float ReleaseTime;
+
+	/** Render thread only. */
+	float Envelope = 0.0f;
+	int32 CoefficientSampleRate = 0;
+	float AttackCoefficient = 0.0f;
+	float ReleaseCoefficient = 0.0f;
+
+	std::atomic<float> Gain { 1.0f };
+};
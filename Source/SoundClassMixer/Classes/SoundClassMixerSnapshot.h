@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include "Engine/DataAsset.h"
+#include "Components/AudioComponent.h"
+
+#include "SoundClassMixerSnapshot.generated.h"
+
+class USoundClass;
+class USoundSubmix;
+
+
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerSnapshotSoundClass
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		USoundClass* SoundClass = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot, meta = (ClampMin = "0.0"))
+		float Volume = 1.0f;
+
+	/** Zero sets the volume immediately. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot, meta = (ClampMin = "0.0"))
+		float Duration = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		EAudioFaderCurve FadeCurve = EAudioFaderCurve::Linear;
+};
+
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerSnapshotSoundSubmix
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		USoundSubmix* SoundSubmix = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot, meta = (ClampMin = "0.0"))
+		float Volume = 1.0f;
+
+	/** Zero sets the volume immediately. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot, meta = (ClampMin = "0.0"))
+		float Duration = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		EAudioFaderCurve FadeCurve = EAudioFaderCurve::Linear;
+};
+
+
+/**
+ * A set of SoundClass/SoundSubmix volume targets applied together, see ApplyMixerSnapshot.
+ * Targets are hard references, so they are resolved when the snapshot itself loads.
+ */
+UCLASS(BlueprintType)
+class SOUNDCLASSMIXER_API USoundClassMixerSnapshot : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		TArray<FSoundClassMixerSnapshotSoundClass> SoundClasses;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Snapshot)
+		TArray<FSoundClassMixerSnapshotSoundSubmix> SoundSubmixes;
+};
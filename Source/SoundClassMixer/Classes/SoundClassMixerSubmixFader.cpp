@@ -0,0 +1,102 @@
+﻿#include "SoundClassMixerSubmixFader.h"
+
+#include "DSP/BufferVectorOperations.h"
+
+
+void FSoundClassMixerSubmixFaderState::Publish(const float InGain, const int32 FadeId, const float ElapsedTime)
+{
+	uint32 ElapsedTimeBits;
+	FMemory::Memcpy(&ElapsedTimeBits, &ElapsedTime, sizeof(ElapsedTimeBits));
+
+	Gain.store(InGain, std::memory_order_relaxed);
+	FadeProgress.store(static_cast<uint64>(static_cast<uint32>(FadeId)) << 32 | ElapsedTimeBits, std::memory_order_release);
+}
+
+int32 FSoundClassMixerSubmixFaderState::GetFadeProgress(float& OutElapsedTime) const
+{
+	const uint64 Progress = FadeProgress.load(std::memory_order_acquire);
+
+	const uint32 ElapsedTimeBits = static_cast<uint32>(Progress);
+	FMemory::Memcpy(&OutElapsedTime, &ElapsedTimeBits, sizeof(OutElapsedTime));
+	return static_cast<int32>(Progress >> 32);
+}
+
+
+void FSoundClassMixerSubmixFader::Init(const FSoundEffectSubmixInitData& InitData)
+{
+	SampleRate = InitData.SampleRate;
+}
+
+void FSoundClassMixerSubmixFader::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SoundClassMixerSubmixFader);
+
+	if (!State)
+	{
+		if (const USoundClassMixerSubmixFaderPreset* FaderPreset = Cast<USoundClassMixerSubmixFaderPreset>(GetPreset()))
+		{
+			State = FaderPreset->GetState();
+		}
+	}
+
+	if (Settings.FadeId == LastFadeId)
+	{
+		return;
+	}
+
+	// The first settings seen may already be a fade; it starts from the submix's gain, not unity.
+	if (LastFadeId == INDEX_NONE)
+	{
+		Fader.SetVolume(Settings.InitialVolume);
+		LastGain = Settings.InitialVolume;
+	}
+	LastFadeId = Settings.FadeId;
+	FadeElapsedTime = 0.0f;
+
+	if (Settings.bStopFade)
+	{
+		Fader.StopFade();
+		return;
+	}
+
+	// Zero duration sets the volume immediately.
+	Fader.StartFade(Settings.TargetVolume, Settings.Duration, static_cast<Audio::EFaderCurve>(Settings.FadeCurve));
+}
+
+void FSoundClassMixerSubmixFader::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
+{
+	const Audio::AlignedFloatBuffer& InBuffer = *InData.AudioBuffer;
+	Audio::AlignedFloatBuffer& OutBuffer = *OutData.AudioBuffer;
+	FMemory::Memcpy(OutBuffer.GetData(), InBuffer.GetData(), InBuffer.Num() * sizeof(float));
+
+	const float DeltaTime = static_cast<float>(InData.NumFrames) / SampleRate;
+	Fader.Update(DeltaTime);
+	FadeElapsedTime += DeltaTime;
+	const float Gain = Fader.GetVolume();
+
+	// Ramp from the previous buffer's gain so steps never land on a buffer boundary.
+	if (!FMath::IsNearlyEqual(LastGain, Gain))
+	{
+		Audio::FadeBufferFast(OutBuffer, LastGain, Gain);
+	}
+	else if (!FMath::IsNearlyEqual(Gain, 1.0f))
+	{
+		Audio::MultiplyBufferByConstantInPlace(OutBuffer, Gain);
+	}
+
+	LastGain = Gain;
+
+	if (State)
+	{
+		State->Publish(Gain, LastFadeId, FadeElapsedTime);
+	}
+}
+
+
+// =====================================================================================================================
+
+
+void USoundClassMixerSubmixFaderPreset::SetSettings(const FSoundClassMixerSubmixFaderSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
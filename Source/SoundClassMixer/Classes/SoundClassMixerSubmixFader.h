@@ -0,0 +1,109 @@
+﻿#pragma once
+
+#include "SimpleFader.h"
+#include "Sound/SoundEffectSubmix.h"
+#include "Components/AudioComponent.h"
+
+#include <atomic>
+
+#include "SoundClassMixerSubmixFader.generated.h"
+
+
+/** Fade request handed to the render thread fader; applied once per FadeId change. */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerSubmixFaderSettings
+{
+	GENERATED_BODY()
+
+	/** Gain the effect starts from when its instance is created; later settings keep it unchanged. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		float InitialVolume = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		float TargetVolume = 1.0f;
+
+	/** Zero sets the volume on the next buffer. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		float Duration = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		EAudioFaderCurve FadeCurve = EAudioFaderCurve::Linear;
+
+	/** Freeze the current gain instead of fading. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		bool bStopFade = false;
+
+	/** Bumped for every new request so repeated identical requests still restart the fade. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset)
+		int32 FadeId = 0;
+};
+
+
+/**
+ * Published by the fader effect after every buffer, so the subsystem reads the fade's progress on the audio clock
+ * instead of timing it itself. Owned by the preset and shared with its effect instances.
+ */
+struct SOUNDCLASSMIXER_API FSoundClassMixerSubmixFaderState
+{
+	/** Gain at the end of the last processed buffer. */
+	std::atomic<float> Gain { 1.0f };
+
+	/** Running fade's FadeId in the high half, audio time it has run for in the low half (float bits). */
+	std::atomic<uint64> FadeProgress { 0 };
+
+	void Publish(float InGain, int32 FadeId, float ElapsedTime);
+
+	/** Returns the FadeId the effect is running and writes how long it has run for. */
+	int32 GetFadeProgress(float& OutElapsedTime) const;
+};
+
+
+/**
+ * Submix effect that advances an FSimpleFader on the audio render thread.
+ * The fader is stepped by each buffer's duration and the gain is ramped across
+ * the buffer, so fade timing follows the audio clock instead of the game tick.
+ */
+class SOUNDCLASSMIXER_API FSoundClassMixerSubmixFader : public FSoundEffectSubmix
+{
+public:
+	virtual void Init(const FSoundEffectSubmixInitData& InitData) override;
+	virtual void OnPresetChanged() override;
+	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
+
+private:
+	FSimpleFader Fader;
+
+	/** The preset's, picked up with its first settings. */
+	TSharedPtr<FSoundClassMixerSubmixFaderState, ESPMode::ThreadSafe> State;
+
+	/** Gain at the end of the last processed buffer. */
+	float LastGain = 1.0f;
+
+	/** Audio time since LastFadeId started. */
+	float FadeElapsedTime = 0.0f;
+
+	float SampleRate = 48000.0f;
+
+	int32 LastFadeId = INDEX_NONE;
+};
+
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class SOUNDCLASSMIXER_API USoundClassMixerSubmixFaderPreset : public USoundEffectSubmixPreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SoundClassMixerSubmixFader)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects")
+		void SetSettings(const FSoundClassMixerSubmixFaderSettings& InSettings);
+
+	const TSharedRef<FSoundClassMixerSubmixFaderState, ESPMode::ThreadSafe>& GetState() const { return State; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SubmixEffectPreset, meta = (ShowOnlyInnerProperties))
+		FSoundClassMixerSubmixFaderSettings Settings;
+
+private:
+	TSharedRef<FSoundClassMixerSubmixFaderState, ESPMode::ThreadSafe> State = MakeShared<FSoundClassMixerSubmixFaderState, ESPMode::ThreadSafe>();
+};
@@ -1,6 +1,194 @@
 ﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
 #include "USoundBaseWrapper.h"
+#include "SoundBaseWrapperCache.h"
+#include "SoundClassMixerSettings.h"
+#include "ActiveSound.h"
+#include "AudioDevice.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
 #include "Kismet/GameplayStatics.h"
+#include "Sound/SoundAttenuation.h"
+#include "Sound/SoundSubmixSend.h"
+
+
+namespace SoundClassMixerPlayNodesPrivate
+{
+	bool UseSubmixSend(const USoundSubmixBase* SubmixOverride)
+	{
+		return SubmixOverride
+			&& GetDefault<USoundClassMixerSettings>()->SubmixOverrideMode == ESoundClassMixerSubmixOverrideMode::SubmixSend;
+	}
+
+	/** Base submix output off, full level send to the override. */
+	void SetSubmixOverride(FActiveSound& ActiveSound, USoundSubmixBase* SubmixOverride)
+	{
+		FSoundSubmixSendInfo SendInfo;
+		SendInfo.SoundSubmix = SubmixOverride;
+		SendInfo.SendLevel   = 1.0f;
+
+		ActiveSound.bHasActiveMainSubmixOutputOverride = true;
+		ActiveSound.bEnableMainSubmixOutputOverride = false;
+		ActiveSound.SetSubmixSend(SendInfo);
+	}
+
+	/** Reroutes the active sound of the component's current play. */
+	void RouteToSubmixOverride(const UAudioComponent* AudioComponent, USoundSubmixBase* SubmixOverride)
+	{
+		FAudioDevice* AudioDevice = AudioComponent ? AudioComponent->GetAudioDevice() : nullptr;
+		if (!AudioDevice || !SubmixOverride)
+		{
+			return;
+		}
+
+		// Queued on the audio thread behind the play request, so it lands before the first buffer.
+		AudioDevice->SendCommandToActiveSounds(AudioComponent->GetAudioComponentID(), [SubmixOverride](FActiveSound& ActiveSound)
+		{
+			SetSubmixOverride(ActiveSound, SubmixOverride);
+		});
+	}
+
+	/**
+	 * Reroutes the current play and any active sound it restarts until the sound stops, then unbinds;
+	 * each spawn call only ever leaves one binding behind while its sound plays.
+	 */
+	void RouteComponentToSubmixOverride(UAudioComponent* AudioComponent, USoundSubmixBase* SubmixOverride)
+	{
+		if (!AudioComponent)
+		{
+			return;
+		}
+
+		RouteToSubmixOverride(AudioComponent, SubmixOverride);
+
+		// Filled in once bound; the lambda needs its own handle to remove itself.
+		TSharedRef<FDelegateHandle> Handle = MakeShared<FDelegateHandle>();
+		TWeakObjectPtr<USoundSubmixBase> WeakSubmixOverride(SubmixOverride);
+		*Handle = AudioComponent->OnAudioPlayStateChangedNative.AddLambda(
+			[WeakSubmixOverride, Handle](const UAudioComponent* Component, const EAudioComponentPlayState PlayState)
+			{
+				if (PlayState == EAudioComponentPlayState::Playing || PlayState == EAudioComponentPlayState::FadingIn)
+				{
+					RouteToSubmixOverride(Component, WeakSubmixOverride.Get());
+				}
+				else if (PlayState == EAudioComponentPlayState::Stopped)
+				{
+					// Safe during the broadcast, the delegate compacts its invocation list afterwards.
+					const_cast<UAudioComponent*>(Component)->OnAudioPlayStateChangedNative.Remove(*Handle);
+				}
+			}
+		);
+	}
+
+	/** Same owner fallback as UGameplayStatics uses when no OwningActor is passed. */
+	const AActor* GetOwner(const UObject* WorldContextObject, const AActor* OwningActor)
+	{
+		if (OwningActor || !WorldContextObject)
+		{
+			return OwningActor;
+		}
+
+		if (const AActor* Actor = Cast<AActor>(WorldContextObject))
+		{
+			return Actor;
+		}
+		return WorldContextObject->GetTypedOuter<AActor>();
+	}
+
+	/** World and device a one-shot plays on, null when audio playback is off there. */
+	FAudioDevice* GetOneShotAudioDevice(const UObject* WorldContextObject, UWorld*& OutWorld)
+	{
+		OutWorld = GEngine && GEngine->UseSound()
+			? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull)
+			: nullptr;
+
+		if (!OutWorld || !OutWorld->bAllowAudioPlayback || OutWorld->IsNetMode(NM_DedicatedServer))
+		{
+			return nullptr;
+		}
+		return OutWorld->GetAudioDeviceRaw();
+	}
+
+	/**
+	 * Queues a one-shot's active sound rerouted to SubmixOverride, with no audio component.
+	 * Mirrors UGameplayStatics::PlaySound2D (no Location) and FAudioDevice::PlaySoundAtLocation as of 4.27,
+	 * including their owner fallback, culling and attenuation. Known divergences: the override is a submix
+	 * send rather than a base submix, and sound modulation default routing isn't applied.
+	 */
+	void PlayOneShot(
+		const UObject* WorldContextObject,
+		USoundBase* Sound,
+		const FTransform* Transform,
+		const float VolumeMultiplier, const float PitchMultiplier, const float StartTime,
+		USoundAttenuation* AttenuationSettings, USoundConcurrency* ConcurrencySettings,
+		const AActor* OwningActor,
+		const bool bIsUISound,
+		USoundSubmixBase* SubmixOverride
+	)
+	{
+		UWorld* World = nullptr;
+		FAudioDevice* AudioDevice = GetOneShotAudioDevice(WorldContextObject, World);
+		if (!AudioDevice)
+		{
+			return;
+		}
+
+		FActiveSound NewActiveSound;
+		NewActiveSound.SetSound(Sound);
+		NewActiveSound.SetWorld(World);
+		NewActiveSound.SetPitch(PitchMultiplier);
+		NewActiveSound.SetVolume(VolumeMultiplier);
+		NewActiveSound.RequestedStartTime = FMath::Max(0.0f, StartTime);
+		NewActiveSound.bHandleSubtitles = true;
+		NewActiveSound.SubtitlePriority = Sound->GetSubtitlePriority();
+		NewActiveSound.Priority = Sound->Priority;
+		if (ConcurrencySettings)
+		{
+			NewActiveSound.ConcurrencySet.Add(ConcurrencySettings);
+		}
+		NewActiveSound.SetOwner(GetOwner(WorldContextObject, OwningActor));
+
+		if (!Transform)
+		{
+			NewActiveSound.bIsUISound = bIsUISound;
+			NewActiveSound.bAllowSpatialization = false;
+		}
+		else
+		{
+			// Not audible if the ticking level collection is not visible.
+			if (World->GetActiveLevelCollection() && !World->GetActiveLevelCollection()->IsVisible())
+			{
+				return;
+			}
+
+			const FVector Location = Transform->GetLocation();
+			const FSoundAttenuationSettings* AttenuationSettingsToApply = AttenuationSettings ? &AttenuationSettings->Attenuation : Sound->GetAttenuationSettingsToApply();
+			float MaxDistance = 0.0f;
+			float FocusFactor = 1.0f;
+			AudioDevice->GetMaxDistanceAndFocusFactor(Sound, World, Location, AttenuationSettingsToApply, MaxDistance, FocusFactor);
+
+			// Short sounds that start out of range of every listener are culled, as the engine does.
+			if (!Sound->IsLooping() && !AudioDevice->SoundIsAudible(Sound, World, Location, AttenuationSettingsToApply, MaxDistance, FocusFactor))
+			{
+				return;
+			}
+
+			NewActiveSound.bLocationDefined = true;
+			NewActiveSound.Transform = *Transform;
+			NewActiveSound.bIsUISound = !World->IsGameWorld();
+			NewActiveSound.bHasAttenuationSettings = AudioDevice->ShouldUseAttenuation(World) && AttenuationSettingsToApply;
+			if (NewActiveSound.bHasAttenuationSettings)
+			{
+				NewActiveSound.AttenuationSettings = *AttenuationSettingsToApply;
+				NewActiveSound.FocusData.PriorityScale = AttenuationSettingsToApply->GetFocusPriorityScale(AudioDevice->GetGlobalFocusSettings(), FocusFactor);
+			}
+			NewActiveSound.MaxDistance = MaxDistance;
+		}
+
+		SetSubmixOverride(NewActiveSound, SubmixOverride);
+		AudioDevice->AddNewActiveSound(NewActiveSound);
+	}
+}
 
 
 void USoundClassMixerBlueprintFunctionLibrary::PlaySound2D_WithSubmixOverride(
@@ -15,13 +203,26 @@ void USoundClassMixerBlueprintFunctionLibrary::PlaySound2D_WithSubmixOverride(
 {
 	if (!Sound)
 	{
-		UE_LOG(LogSoundClassMixer, Error, TEXT("[USoundClassMixerBlueprintFunctionLibrary::SpawnSoundAttached_WithSubmixOverride] Sound was not set."));
+		UE_LOG(LogSoundClassMixer, Error, TEXT("[USoundClassMixerBlueprintFunctionLibrary::PlaySound2D_WithSubmixOverride] Sound was not set."));
 		return;
 	}
 	
-	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
-	Wrapper->InheritSoundBase(Sound);
-	Wrapper->SoundSubmixOverride = SubmixOverride;
+	if (SoundClassMixerPlayNodesPrivate::UseSubmixSend(SubmixOverride))
+	{
+		SoundClassMixerPlayNodesPrivate::PlayOneShot(
+			WorldContextObject,
+			Sound,
+			nullptr,
+			VolumeMultiplier, PitchMultiplier, StartTime,
+			nullptr, ConcurrencySettings,
+			OwningActor,
+			bIsUISound,
+			SubmixOverride
+		);
+		return;
+	}
+	
+	USoundBaseWrapper* Wrapper = FSoundBaseWrapperCache::Get().FindOrAdd(Sound, SubmixOverride);
 	
 	UGameplayStatics::PlaySound2D(
 		WorldContextObject,
@@ -49,9 +250,23 @@ void USoundClassMixerBlueprintFunctionLibrary::PlaySoundAtLocation_WithSubmixOve
 		return;
 	}
 	
-	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
-	Wrapper->InheritSoundBase(Sound);
-	Wrapper->SoundSubmixOverride = SubmixOverride;
+	if (SoundClassMixerPlayNodesPrivate::UseSubmixSend(SubmixOverride))
+	{
+		const FTransform Transform(Rotation, Location);
+		SoundClassMixerPlayNodesPrivate::PlayOneShot(
+			WorldContextObject,
+			Sound,
+			&Transform,
+			VolumeMultiplier, PitchMultiplier, StartTime,
+			AttenuationSettings, ConcurrencySettings,
+			OwningActor,
+			false,
+			SubmixOverride
+		);
+		return;
+	}
+	
+	USoundBaseWrapper* Wrapper = FSoundBaseWrapperCache::Get().FindOrAdd(Sound, SubmixOverride);
 	
 	UGameplayStatics::PlaySoundAtLocation(
 		WorldContextObject,
@@ -81,9 +296,23 @@ UAudioComponent* USoundClassMixerBlueprintFunctionLibrary::SpawnSoundAttached_Wi
 		return nullptr;
 	}
 	
-	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
-	Wrapper->InheritSoundBase(Sound);
-	Wrapper->SoundSubmixOverride = SubmixOverride;
+	if (SoundClassMixerPlayNodesPrivate::UseSubmixSend(SubmixOverride))
+	{
+		UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAttached(
+			Sound,
+			AttachToComponent, AttachPointName,
+			Location, Rotation, LocationType,
+			bStopWhenAttachedToDestroyed,
+			VolumeMultiplier, PitchMultiplier, StartTime,
+			AttenuationSettings, ConcurrencySettings,
+			bAutoDestroy
+		);
+
+		SoundClassMixerPlayNodesPrivate::RouteComponentToSubmixOverride(AudioComponent, SubmixOverride);
+		return AudioComponent;
+	}
+	
+	USoundBaseWrapper* Wrapper = FSoundBaseWrapperCache::Get().FindOrAdd(Sound, SubmixOverride);
 	
 	return UGameplayStatics::SpawnSoundAttached(
 		Wrapper,
@@ -112,9 +341,21 @@ UAudioComponent* USoundClassMixerBlueprintFunctionLibrary::SpawnSoundAtLocation_
 		return nullptr;
 	}
 	
-	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
-	Wrapper->InheritSoundBase(Sound);
-	Wrapper->SoundSubmixOverride = SubmixOverride;
+	if (SoundClassMixerPlayNodesPrivate::UseSubmixSend(SubmixOverride))
+	{
+		UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAtLocation(
+			WorldContextObject,
+			Sound,
+			Location, Rotation,
+			VolumeMultiplier, PitchMultiplier, StartTime,
+			AttenuationSettings, ConcurrencySettings, bAutoDestroy
+		);
+
+		SoundClassMixerPlayNodesPrivate::RouteComponentToSubmixOverride(AudioComponent, SubmixOverride);
+		return AudioComponent;
+	}
+	
+	USoundBaseWrapper* Wrapper = FSoundBaseWrapperCache::Get().FindOrAdd(Sound, SubmixOverride);
 	
 	return UGameplayStatics::SpawnSoundAtLocation(
 		WorldContextObject,
@@ -141,9 +382,22 @@ UAudioComponent* USoundClassMixerBlueprintFunctionLibrary::SpawnSound2D_WithSubm
 		return nullptr;
 	}
 	
-	USoundBaseWrapper* Wrapper = NewObject<USoundBaseWrapper>(GetTransientPackage());
-	Wrapper->InheritSoundBase(Sound);
-	Wrapper->SoundSubmixOverride = SubmixOverride;
+	if (SoundClassMixerPlayNodesPrivate::UseSubmixSend(SubmixOverride))
+	{
+		UAudioComponent* AudioComponent = UGameplayStatics::SpawnSound2D(
+			WorldContextObject,
+			Sound,
+			VolumeMultiplier, PitchMultiplier, StartTime,
+			ConcurrencySettings,
+			bPersistAcrossLevelTransition,
+			bAutoDestroy
+		);
+
+		SoundClassMixerPlayNodesPrivate::RouteComponentToSubmixOverride(AudioComponent, SubmixOverride);
+		return AudioComponent;
+	}
+	
+	USoundBaseWrapper* Wrapper = FSoundBaseWrapperCache::Get().FindOrAdd(Sound, SubmixOverride);
 	
 	return UGameplayStatics::SpawnSound2D(
 		WorldContextObject,
@@ -0,0 +1,92 @@
+﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
+
+#include "SoundClassMixerSubsystem.h"
+
+
+// =====================================================================================================================
+
+
+FMixerChannelHandle USoundClassMixerBlueprintFunctionLibrary::GetSoundClassChannel(const UObject* WorldContextObject, USoundClass* TargetClass)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return FMixerChannelHandle();
+	}
+
+	return SoundClassMixerSubsystem->GetSoundClassChannel(TargetClass);
+}
+
+FMixerChannelHandle USoundClassMixerBlueprintFunctionLibrary::GetSoundSubmixChannel(const UObject* WorldContextObject, USoundSubmix* TargetSubmix)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return FMixerChannelHandle();
+	}
+
+	return SoundClassMixerSubsystem->GetSoundSubmixChannel(TargetSubmix);
+}
+
+bool USoundClassMixerBlueprintFunctionLibrary::IsMixerChannelValid(const UObject* WorldContextObject, const FMixerChannelHandle Channel)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return false;
+	}
+
+	return SoundClassMixerSubsystem->IsChannelValid(Channel);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::MixerChannelFadeTo(
+	const UObject* WorldContextObject,
+	const FMixerChannelHandle Channel, const float FadeDuration, const float FadeVolumeLevel,
+	const EAudioFaderCurve FadeCurve
+)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->AdjustChannelVolumeInternal(
+		Channel,
+		FadeDuration, FadeVolumeLevel,
+		FadeCurve
+	);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::SetMixerChannelVolume(const UObject* WorldContextObject, const FMixerChannelHandle Channel, const float NewVolume)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->SetChannelVolumeInternal(Channel, NewVolume);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::StopMixerChannelFade(const UObject* WorldContextObject, const FMixerChannelHandle Channel)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->StopChannelFadeInternal(Channel);
+}
+
+float USoundClassMixerBlueprintFunctionLibrary::GetMixerChannelVolume(const UObject* WorldContextObject, const FMixerChannelHandle Channel)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return 0.0f;
+	}
+
+	return SoundClassMixerSubsystem->GetChannelVolumeInternal(Channel);
+}
@@ -0,0 +1,55 @@
+﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
+
+#include "SoundClassMixerSubsystem.h"
+
+
+// =====================================================================================================================
+
+
+int32 USoundClassMixerBlueprintFunctionLibrary::PushSoundClassDuck(const UObject* WorldContextObject, const FSoundClassMixerDuckRequest& Request)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return INDEX_NONE;
+	}
+
+	return SoundClassMixerSubsystem->PushDuck(Request);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::ReleaseSoundClassDuck(const UObject* WorldContextObject, const int32 DuckId)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->ReleaseDuck(DuckId);
+}
+
+
+// =====================================================================================================================
+
+
+int32 USoundClassMixerBlueprintFunctionLibrary::AddSubmixSidechain(const UObject* WorldContextObject, const FSoundClassMixerSidechainSettings& Settings)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return INDEX_NONE;
+	}
+
+	return SoundClassMixerSubsystem->AddSidechain(Settings);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::RemoveSubmixSidechain(const UObject* WorldContextObject, const int32 SidechainId)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->RemoveSidechain(SidechainId);
+}
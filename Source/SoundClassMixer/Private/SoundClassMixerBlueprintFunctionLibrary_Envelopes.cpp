@@ -0,0 +1,60 @@
+﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
+
+#include "SoundClassMixerSubsystem.h"
+
+
+// =====================================================================================================================
+
+
+void USoundClassMixerBlueprintFunctionLibrary::SoundClassRunEnvelope(const UObject* WorldContextObject, USoundClass* TargetClass, const FSoundClassMixerEnvelope& Envelope)
+{
+	if (!TargetClass)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
+		return;
+	}
+
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->RunEnvelopeInternal(
+		TargetClass, ESoundClassMixerTargetType::SoundClass,
+		SoundClassMixerSubsystem->GetSoundClassChannel(TargetClass),
+		Envelope
+	);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::SoundSubmixRunEnvelope(const UObject* WorldContextObject, USoundSubmix* TargetSubmix, const FSoundClassMixerEnvelope& Envelope)
+{
+	if (!TargetSubmix)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
+		return;
+	}
+
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->RunEnvelopeInternal(
+		TargetSubmix, ESoundClassMixerTargetType::SoundSubmix,
+		SoundClassMixerSubsystem->GetSoundSubmixChannel(TargetSubmix),
+		Envelope
+	);
+}
+
+void USoundClassMixerBlueprintFunctionLibrary::MixerChannelRunEnvelope(const UObject* WorldContextObject, const FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope)
+{
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->RunChannelEnvelopeInternal(Channel, Envelope);
+}
@@ -0,0 +1,25 @@
+﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
+
+#include "SoundClassMixerSnapshot.h"
+#include "SoundClassMixerSubsystem.h"
+
+
+// =====================================================================================================================
+
+
+void USoundClassMixerBlueprintFunctionLibrary::ApplyMixerSnapshot(const UObject* WorldContextObject, USoundClassMixerSnapshot* Snapshot)
+{
+	if (!Snapshot)
+	{
+		UE_LOG(LogSoundClassMixer, Error, TEXT("Mixer Snapshot was not set."));
+		return;
+	}
+
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->ApplyMixerSnapshotInternal(Snapshot);
+}
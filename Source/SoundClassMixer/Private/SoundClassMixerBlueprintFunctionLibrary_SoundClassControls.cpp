@@ -3,7 +3,6 @@
 #include "AudioDevice.h"
 #include "SoundClassMixerSubsystem.h"
 #include "Components/AudioComponent.h"
-#include "Engine/Engine.h"
 
 
 // =====================================================================================================================
@@ -22,21 +21,16 @@ void USoundClassMixerBlueprintFunctionLibrary::SoundClassFadeTo(
 		return;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
-	checkf(World, TEXT("World is invalid."))
-
-	const UGameInstance* GI = World->GetGameInstance();
-	checkf(GI, TEXT("GI is invalid."))
-	
-	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GI->GetSubsystem<USoundClassMixerSubsystem>();
-	checkf(SoundClassMixerSubsystem, TEXT("SoundClassMixerSubsystem is invalid."))
-
-	checkf(SoundClassMixerSubsystem->SoundClassMap.Find(TargetClass), TEXT("SoundClass Properties are not found."))
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
 
 	SoundClassMixerSubsystem->AdjustSoundClassVolumeInternal(
 		TargetClass,
 		FadeDuration, FadeVolumeLevel,
-		TargetClass->Properties.Volume > FadeVolumeLevel,
+		SoundClassMixerSubsystem->GetSoundClassVolumeInternal(TargetClass) > FadeVolumeLevel,
 		FadeCurve
 	);
 }
@@ -49,26 +43,46 @@ void USoundClassMixerBlueprintFunctionLibrary::SetSoundClassVolume(const UObject
 		return;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
-	checkf(World, TEXT("World is invalid."))
-
-	const UGameInstance* GI = World->GetGameInstance();
-	checkf(GI, TEXT("GI is invalid."))
-	
-	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GI->GetSubsystem<USoundClassMixerSubsystem>();
-	checkf(SoundClassMixerSubsystem, TEXT("SoundClassMixerSubsystem is invalid."))
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
 
 	SoundClassMixerSubsystem->SetSoundClassVolumeInternal(
 		TargetClass, NewVolume
 	);
 }
 
-float USoundClassMixerBlueprintFunctionLibrary::GetSoundClassVolume(USoundClass* TargetClass)
+void USoundClassMixerBlueprintFunctionLibrary::StopSoundClassFade(const UObject* WorldContextObject, USoundClass* TargetClass)
+{
+	if (!TargetClass)
+	{
+		UE_LOG(LogSoundClassMixer, Error, TEXT("Could not find Sound Class!"));
+		return;
+	}
+
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->StopSoundClassFadeInternal(TargetClass);
+}
+
+float USoundClassMixerBlueprintFunctionLibrary::GetSoundClassVolume(const UObject* WorldContextObject, USoundClass* TargetClass)
 {
 	if (!TargetClass)
 	{
 		return -1.f;
 	}
 	
-	return TargetClass->Properties.Volume;
+	const USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return -1.f;
+	}
+
+	return SoundClassMixerSubsystem->GetSoundClassVolumeInternal(TargetClass);
 }
@@ -16,21 +16,16 @@ void USoundClassMixerBlueprintFunctionLibrary::SoundSubmixFadeTo(
 		return;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
-	checkf(World, TEXT("World is invalid."))
-
-	const UGameInstance* GI = World->GetGameInstance();
-	checkf(GI, TEXT("GI is invalid."))
-	
-	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GI->GetSubsystem<USoundClassMixerSubsystem>();
-	checkf(SoundClassMixerSubsystem, TEXT("SoundClassMixerSubsystem is invalid."))
-
-	checkf(SoundClassMixerSubsystem->SoundSubmixMap.Find(TargetClass), TEXT("SoundSubmix Properties are not found."))
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
 
 	SoundClassMixerSubsystem->AdjustSoundSubmixVolumeInternal(
 		TargetClass,
 		FadeDuration, FadeVolumeLevel,
-		TargetClass->OutputVolume > FadeVolumeLevel,
+		SoundClassMixerSubsystem->GetSoundSubmixVolumeInternal(TargetClass) > FadeVolumeLevel,
 		FadeCurve
 	);
 }
@@ -43,26 +38,46 @@ void USoundClassMixerBlueprintFunctionLibrary::SetSoundSubmixVolume(const UObjec
 		return;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
-	checkf(World, TEXT("World is invalid."))
-
-	const UGameInstance* GI = World->GetGameInstance();
-	checkf(GI, TEXT("GI is invalid."))
-	
-	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GI->GetSubsystem<USoundClassMixerSubsystem>();
-	checkf(SoundClassMixerSubsystem, TEXT("SoundClassMixerSubsystem is invalid."))
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
 
 	SoundClassMixerSubsystem->SetSoundSubmixVolumeInternal(
 		TargetClass, NewVolume
 	);
 }
 
-float USoundClassMixerBlueprintFunctionLibrary::GetSoundSubmixVolume(USoundSubmix* TargetClass)
+void USoundClassMixerBlueprintFunctionLibrary::StopSoundSubmixFade(const UObject* WorldContextObject, USoundSubmix* TargetClass)
+{
+	if (!TargetClass)
+	{
+		UE_LOG(LogSoundClassMixer, Error, TEXT("Could not find Sound Submix"));
+		return;
+	}
+
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return;
+	}
+
+	SoundClassMixerSubsystem->StopSoundSubmixFadeInternal(TargetClass);
+}
+
+float USoundClassMixerBlueprintFunctionLibrary::GetSoundSubmixVolume(const UObject* WorldContextObject, USoundSubmix* TargetClass)
 {
 	if (!TargetClass)
 	{
 		return -1.f;
 	}
 	
-	return TargetClass->OutputVolume;
+	const USoundClassMixerSubsystem* SoundClassMixerSubsystem = GetMixerSubsystem(WorldContextObject);
+	if (!SoundClassMixerSubsystem)
+	{
+		return -1.f;
+	}
+
+	return SoundClassMixerSubsystem->GetSoundSubmixVolumeInternal(TargetClass);
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 ﻿#include "SoundClassMixerBlueprintFunctionLibrary.h"
 
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
 
 float USoundClassMixerBlueprintFunctionLibrary::ConvertToLinear(float Value)
 {
@@ -9,4 +13,23 @@ float USoundClassMixerBlueprintFunctionLibrary::ConvertToLinear(float Value)
 float USoundClassMixerBlueprintFunctionLibrary::ConvertToDecibels(const float Value)
 {
 	return Audio::ConvertToDecibels(Value);
-}
\ No newline at end of file
+}
+
+
+// =====================================================================================================================
+
+
+USoundClassMixerSubsystem* USoundClassMixerBlueprintFunctionLibrary::GetMixerSubsystem(const UObject* WorldContextObject)
+{
+	// Every node is CallableWithoutWorldContext, so a missing world is a caller error, not an invariant.
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	USoundClassMixerSubsystem* SoundClassMixerSubsystem = GI ? GI->GetSubsystem<USoundClassMixerSubsystem>() : nullptr;
+
+	if (!SoundClassMixerSubsystem)
+	{
+		UE_LOG(LogSoundClassMixer, Warning, TEXT("No SoundClassMixerSubsystem for %s (world %s), ignoring the call."),
+			*GetNameSafe(WorldContextObject), *GetNameSafe(World));
+	}
+	return SoundClassMixerSubsystem;
+}
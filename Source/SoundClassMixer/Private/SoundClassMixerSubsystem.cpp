@@ -2,11 +2,77 @@
 
 #include "ActiveSound.h"
 #include "AudioDevice.h"
+#include "AudioDeviceManager.h"
+#include "SoundClassMixerManifest.h"
 #include "SoundClassMixerSettings.h"
+#include "SoundClassMixerSnapshot.h"
+#include "SoundClassMixerSubmixFader.h"
+#include "AudioMixerBlueprintLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "Sound/SoundClass.h"
+#include "Sound/SoundMix.h"
 #include "Sound/SoundSubmix.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Command Queue Depth"), STAT_SoundClassMixerCommandQueueDepth, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Command Queue Overflows"), STAT_SoundClassMixerCommandQueueOverflows, STATGROUP_SoundClassMixer);
+DECLARE_CYCLE_STAT(TEXT("Drain Commands"), STAT_SoundClassMixerDrainCommands, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Idle Frames Skipped"), STAT_SoundClassMixerIdleFrames, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Fades"), STAT_SoundClassMixerActiveFades, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Commands Enqueued"), STAT_SoundClassMixerCommandsEnqueued, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Commands Coalesced"), STAT_SoundClassMixerCommandsCoalesced, STATGROUP_SoundClassMixer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Device Calls Skipped"), STAT_SoundClassMixerDeviceCallsSkipped, STATGROUP_SoundClassMixer);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Command Latency (ms)"), STAT_SoundClassMixerCommandLatency, STATGROUP_SoundClassMixer);
+DECLARE_CYCLE_STAT(TEXT("Fader Update"), STAT_SoundClassMixerFaderUpdate, STATGROUP_SoundClassMixer);
+DECLARE_CYCLE_STAT(TEXT("Submix Apply"), STAT_SoundClassMixerSubmixApply, STATGROUP_SoundClassMixer);
+
+// -trace=cpu,counters,SoundClassMixer for Insights; "csvprofile start" (or -csvCategories=SoundClassMixer) for soak captures.
+UE_TRACE_CHANNEL(SoundClassMixerChannel);
+TRACE_DECLARE_INT_COUNTER(SoundClassMixerActiveFades, TEXT("SoundClassMixer/ActiveFades"));
+TRACE_DECLARE_INT_COUNTER(SoundClassMixerCommandsDrained, TEXT("SoundClassMixer/CommandsDrained"));
+TRACE_DECLARE_FLOAT_COUNTER(SoundClassMixerCommandLatency, TEXT("SoundClassMixer/CommandLatencyMs"));
+CSV_DEFINE_CATEGORY(SoundClassMixer, true);
+
+namespace SoundClassMixerSubsystemPrivate
+{
+	/**
+	 * Sets submix device gains from the audio thread, after the effect chain changes queued before it.
+	 * Resolves the device by id so it also runs after the subsystem is gone.
+	 */
+	void SetSubmixOutputVolumesOnAudioThread(const uint32 DeviceId, TArray<TPair<USoundSubmix*, float>> Volumes)
+	{
+		if (DeviceId == static_cast<uint32>(INDEX_NONE) || Volumes.Num() == 0)
+		{
+			return;
+		}
+
+		DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.SetSubmixOutputVolumes"), STAT_SoundClassMixerSetSubmixOutputVolumes, STATGROUP_AudioThreadCommands);
+		FAudioThread::RunCommandOnAudioThread(
+			[DeviceId, Volumes = MoveTemp(Volumes)]
+			{
+				FAudioDeviceManager* DeviceManager = FAudioDeviceManager::Get();
+				FAudioDevice* AudioDevice = DeviceManager ? DeviceManager->GetAudioDeviceRaw(DeviceId) : nullptr;
+				if (!AudioDevice)
+				{
+					return;
+				}
+
+				for (const TPair<USoundSubmix*, float>& Pair : Volumes)
+				{
+					AudioDevice->SetSubmixOutputVolume(Pair.Key, Pair.Value);
+				}
+			},
+			GET_STATID(STAT_SoundClassMixerSetSubmixOutputVolumes)
+		);
+	}
+}
+
 // =====================================================================================================================
 
 void USoundClassMixerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -15,9 +81,17 @@ void USoundClassMixerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	
 	Super::Initialize(Collection);
 	
-	GatherSoundClasses();
-	
 	bInitialized = true;
+
+	if (GetDefault<USoundClassMixerSettings>()->bDeviceScopedVolumes)
+	{
+		// Overrides apply from the moment they are set; the mix itself must not ramp.
+		DeviceSoundMix = NewObject<USoundMix>(this, TEXT("DeviceSoundMix"), RF_Transient);
+		DeviceSoundMix->FadeInTime  = 0.0f;
+		DeviceSoundMix->FadeOutTime = 0.0f;
+	}
+
+	GatherSoundClasses();
 }
 
 void USoundClassMixerSubsystem::Deinitialize()
@@ -25,6 +99,45 @@ void USoundClassMixerSubsystem::Deinitialize()
 	check(bInitialized);
 	
 	bInitialized = false;
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : StreamableHandles)
+	{
+		Handle->CancelHandle();
+	}
+	StreamableHandles.Reset();
+	PendingAssetPaths.Reset();
+	PendingManifestVolumes.Reset();
+	DeferredCommands.Reset();
+	ResolvedSnapshots.Reset();
+	CoalescedCommands.Reset();
+	CoalescedCommandSlots.Reset();
+	NumCoalescedThisFrame = 0;
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		CommandEnvelopes.Reset();
+	}
+
+	RemoveSubmixFaders();
+	RemoveAllSidechains();
+
+	// Updates already queued to the audio thread reference this subsystem, and the unregistered listeners are
+	// released by the audio thread; neither may outlive Deinitialize.
+	if (FAudioThread::IsAudioThreadRunning())
+	{
+		FAudioCommandFence Fence;
+		Fence.BeginFence();
+		Fence.Wait();
+	}
+
+	if (DeviceSoundMix)
+	{
+		if (FAudioDevice* AudioDevice = GetMixerAudioDevice())
+		{
+			AudioDevice->PopSoundMixModifier(DeviceSoundMix);
+		}
+		DeviceSoundMix = nullptr;
+	}
+	AudioDeviceId = static_cast<uint32>(INDEX_NONE);
 	
 	Super::Deinitialize();
 }
@@ -35,7 +148,7 @@ ETickableTickType USoundClassMixerSubsystem::GetTickableTickType() const
 {
 	return IsTemplate()
 		? ETickableTickType::Never
-		: ETickableTickType::Always;
+		: ETickableTickType::Conditional;
 }
 
 bool USoundClassMixerSubsystem::IsTickableWhenPaused() const
@@ -48,22 +161,145 @@ bool USoundClassMixerSubsystem::IsAllowedToTick() const
 	return !IsTemplate() && bInitialized;
 }
 
+bool USoundClassMixerSubsystem::IsTickable() const
+{
+	// Asleep until a command is enqueued; nothing is dispatched to the audio thread meanwhile.
+	// Held commands and unresolved ducks are game thread state; an in-flight update clearing
+	// bHasPendingWork must not strand them.
+	return bHasPendingWork || CoalescedCommands.Num() > 0 || bDucksDirty;
+}
+
 void USoundClassMixerSubsystem::Tick(float DeltaTime)
 {
+	// Counted from the gap since the last tick; IsTickable is queried several times a frame.
+	if (LastTickFrame != 0 && GFrameCounter > LastTickFrame + 1)
+	{
+		INC_DWORD_STAT_BY(STAT_SoundClassMixerIdleFrames, static_cast<uint32>(GFrameCounter - LastTickFrame - 1));
+	}
+	LastTickFrame = GFrameCounter;
+
+	if (bDucksDirty)
+	{
+		ResolveDucks();
+	}
+
 	UpdateAudioClasses();
 }
 
 // =====================================================================================================================
 
 void USoundClassMixerSubsystem::GatherSoundClasses()
+{
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		ReleaseAllChannels();
+	}
+	SoundClassNameIndex.Empty();
+	SoundSubmixNameIndex.Empty();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Cooked builds read the commandlet's pre-filtered list; editor and uncooked builds always scan.
+	bool bGatheredFromManifest = false;
+	if (FPlatformProperties::RequiresCookedData())
+	{
+		FSoundClassMixerManifest Manifest;
+		if (Manifest.LoadFromFile(FSoundClassMixerManifest::GetDefaultFilename()))
+		{
+			if (Manifest.AssetFilterHash == GetDefault<USoundClassMixerSettings>()->GetAssetFilterHash())
+			{
+				GatherFromManifest(Manifest);
+				bGatheredFromManifest = true;
+			}
+			else
+			{
+				UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Mixer manifest %s was written with different filter settings, falling back to an asset registry scan. Re-run the SoundClassMixerManifest commandlet before packaging."),
+					*FSoundClassMixerManifest::GetDefaultFilename());
+			}
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("No mixer manifest at %s, falling back to an asset registry scan. Run the SoundClassMixerManifest commandlet before packaging so the build stages it."),
+				*FSoundClassMixerManifest::GetDefaultFilename());
+		}
+	}
+
+	if (!bGatheredFromManifest)
+	{
+		GatherFromAssetRegistry();
+	}
+
+	RebuildSoundClassHierarchy();
+
+	UE_LOG(LogSoundClassMixerSubsystem, Log, TEXT("Gathered sound classes from %s in %.2f ms."),
+		bGatheredFromManifest ? TEXT("manifest") : TEXT("asset registry"),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void USoundClassMixerSubsystem::GatherFromManifest(const FSoundClassMixerManifest& Manifest)
+{
+	const bool bAsync = GetDefault<USoundClassMixerSettings>()->bAsyncGather;
+	TArray<FSoftObjectPath> AssetPathsToLoad;
+	int32 NumMissing = 0;
+
+	for (const FSoundClassMixerManifestEntry& Entry : Manifest.SoundClasses)
+	{
+		if (bAsync)
+		{
+			AssetPathsToLoad.Add(Entry.Path);
+			PendingManifestVolumes.Add(Entry.Path, Entry.DefaultVolume);
+		}
+		else if (USoundClass* SoundClass = Cast<USoundClass>(Entry.Path.TryLoad()))
+		{
+			RegisterSoundClass(SoundClass, Entry.DefaultVolume);
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Failed to load %s."), *Entry.Path.ToString());
+			++NumMissing;
+		}
+	}
+
+	for (const FSoundClassMixerManifestEntry& Entry : Manifest.SoundSubmixes)
+	{
+		if (bAsync)
+		{
+			AssetPathsToLoad.Add(Entry.Path);
+			PendingManifestVolumes.Add(Entry.Path, Entry.DefaultVolume);
+		}
+		else if (USoundSubmix* SoundSubmix = Cast<USoundSubmix>(Entry.Path.TryLoad()))
+		{
+			RegisterSoundSubmix(SoundSubmix, Entry.DefaultVolume);
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Failed to load %s."), *Entry.Path.ToString());
+			++NumMissing;
+		}
+	}
+
+	if (NumMissing > 0)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("%d mixer manifest entries failed to load; the manifest is likely stale. Re-run the SoundClassMixerManifest commandlet before packaging."), NumMissing);
+	}
+
+	if (bAsync)
+	{
+		RequestAsyncLoad(AssetPathsToLoad);
+	}
+}
+
+void USoundClassMixerSubsystem::GatherFromAssetRegistry()
 {
 	const USoundClassMixerSettings* Settings = GetDefault<USoundClassMixerSettings>();
-	
-	SoundClassMap.Empty();
-	SoundSubmixMap.Empty();
+	const FSoundClassMixerAssetFilter& AssetFilter = Settings->GetAssetFilter();
 	
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	const IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	// Async mode only collects paths here; nothing is loaded until the streamable requests go out.
+	const bool bAsync = Settings->bAsyncGather;
+	TArray<FSoftObjectPath> AssetPathsToLoad;
 	
 	FARFilter SoundClassFilter;
 	SoundClassFilter.ClassNames.Add(USoundClass::StaticClass()->GetFName());
@@ -73,35 +309,22 @@ void USoundClassMixerSubsystem::GatherSoundClasses()
 	AssetRegistry.GetAssets(SoundClassFilter, AssetDataList_SoundClasses);
 	for (const FAssetData& AssetData : AssetDataList_SoundClasses)
 	{
-		if (Settings->ExcludedSoundClassNames.Find(AssetData.AssetName.ToString()) != INDEX_NONE)
-		{
-			UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Excluded SoundClass by Name: %s"), *AssetData.AssetName.ToString());
-			continue;
-		}
-		
-		USoundClass* SoundClass = Cast<USoundClass>(AssetData.GetAsset());
-		if (!SoundClass)
+		if (!AssetFilter.IsSoundClassIncluded(AssetData))
 		{
+			UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Excluded SoundClass: %s"), *AssetData.AssetName.ToString());
 			continue;
 		}
 
-		bool bFoundClassPath = false;
-		for (const TSoftObjectPtr<USoundClass>& Subclass : Settings->ExcludedSoundClasses)
+		if (bAsync)
 		{
-			if (Subclass.ToSoftObjectPath() == AssetData.ToSoftObjectPath())
-			{
-				bFoundClassPath = true;
-				break;
-			}
+			AssetPathsToLoad.Add(AssetData.ToSoftObjectPath());
+			continue;
 		}
-		if (bFoundClassPath)
+		
+		if (USoundClass* SoundClass = Cast<USoundClass>(AssetData.GetAsset()))
 		{
-			UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Excluded SoundClass by Class: %s"), *SoundClass->GetName());
-			continue;
+			RegisterSoundClass(SoundClass);
 		}
-
-		UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Added SoundClass: %s"), *SoundClass->GetName());
-		SoundClassMap.Add(SoundClass);
 	}
 
 	FARFilter SoundSubmixFilter;
@@ -112,264 +335,1964 @@ void USoundClassMixerSubsystem::GatherSoundClasses()
 	AssetRegistry.GetAssets(SoundSubmixFilter, AssetDataList_SoundSubmixes);
 	for (const FAssetData& AssetData : AssetDataList_SoundSubmixes)
 	{
-		USoundSubmix* SoundSubmix = Cast<USoundSubmix>(AssetData.GetAsset());
-		if (!SoundSubmix)
+		if (!AssetFilter.IsSoundSubmixIncluded(AssetData))
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Excluded SoundSubmix: %s"), *AssetData.AssetName.ToString());
+			continue;
+		}
+
+		if (bAsync)
 		{
+			AssetPathsToLoad.Add(AssetData.ToSoftObjectPath());
 			continue;
 		}
 
-		UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Added SoundSubmix: %s"), *SoundSubmix->GetName());
-		SoundSubmixMap.Add(SoundSubmix);
+		if (USoundSubmix* SoundSubmix = Cast<USoundSubmix>(AssetData.GetAsset()))
+		{
+			RegisterSoundSubmix(SoundSubmix);
+		}
 	}
 
-	InitializeFadersOnAudioThread();
+	if (bAsync)
+	{
+		RequestAsyncLoad(AssetPathsToLoad);
+	}
 }
 
-void USoundClassMixerSubsystem::InitializeFadersOnAudioThread()
+void USoundClassMixerSubsystem::RequestAsyncLoad(const TArray<FSoftObjectPath>& AssetPaths)
 {
-	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.InitializeFaders"), STAT_SoundClassMixerInitializeFaders, STATGROUP_AudioThreadCommands);
-	FAudioThread::RunCommandOnAudioThread(
-		[this]
-		{
-			for (TPair<USoundClass*, FSoundSubSysProperties>& Pair : SoundClassMap)
-			{
-				if (Pair.Key)
-				{
-					Pair.Value.Fader.SetVolume(Pair.Key->Properties.Volume);
-				}
-			}
+	const int32 BatchSize = FMath::Max(1, GetDefault<USoundClassMixerSettings>()->AsyncLoadBatchSize);
 
-			for (TPair<USoundSubmix*, FSoundSubSysProperties>& Pair : SoundSubmixMap)
-			{
-				if (Pair.Key)
-				{
-					Pair.Value.Fader.SetVolume(Pair.Key->OutputVolume);
-				}
-			}
-		},
-		GET_STATID(STAT_SoundClassMixerInitializeFaders)
-	);
-}
-
-// =====================================================================================================================
+	PendingAssetPaths.Append(AssetPaths);
 
-void USoundClassMixerSubsystem::SetSoundClassVolumeInternal(
-	const USoundClass* SoundClassAsset,
-	float AdjustVolumeLevel
-)
-{
-	if (!SoundClassAsset)
+	for (int32 BatchStart = 0; BatchStart < AssetPaths.Num(); BatchStart += BatchSize)
 	{
-		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
-		return;
-	}
-
-	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
+		TArray<FSoftObjectPath> Batch(AssetPaths.GetData() + BatchStart, FMath::Min(BatchSize, AssetPaths.Num() - BatchStart));
 
-	FSoundSubSysProperties* FoundSoundClassProps = SoundClassMap.Find(SoundClassAsset);
-	check(FoundSoundClassProps);
+		const TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+			Batch,
+			FStreamableDelegate::CreateUObject(this, &USoundClassMixerSubsystem::OnAsyncLoadBatchCompleted, Batch)
+		);
+		if (Handle.IsValid())
+		{
+			StreamableHandles.Add(Handle);
+		}
+	}
 
-	if (IsInAudioThread())
+	if (PendingAssetPaths.Num() == 0)
 	{
-		FoundSoundClassProps->Fader.SetVolume(AdjustVolumeLevel);
-		const_cast<USoundClass*>(SoundClassAsset)->Properties.Volume = AdjustVolumeLevel;
-		return;
+		OnGatherCompleted();
 	}
-
-	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.SoundClass.SetVolume"), STAT_SoundClassAdjustVolume, STATGROUP_AudioThreadCommands);
-	FAudioThread::RunCommandOnAudioThread(
-		[FoundSoundClassProps, SoundClassAsset, AdjustVolumeLevel]
-		{
-			FoundSoundClassProps->Fader.SetVolume(AdjustVolumeLevel);
-			const_cast<USoundClass*>(SoundClassAsset)->Properties.Volume = AdjustVolumeLevel;
-		},
-		GET_STATID(STAT_SoundClassAdjustVolume)
-	);
 }
 
-
-void USoundClassMixerSubsystem::AdjustSoundClassVolumeInternal(
-	const USoundClass* SoundClassAsset,
-	float AdjustVolumeDuration, float AdjustVolumeLevel,
-	const bool bInIsFadeOut, const EAudioFaderCurve FadeCurve
-)
+void USoundClassMixerSubsystem::OnAsyncLoadBatchCompleted(TArray<FSoftObjectPath> Batch)
 {
-	if (!SoundClassAsset)
+	for (const FSoftObjectPath& AssetPath : Batch)
 	{
-		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
-		return;
+		if (PendingAssetPaths.Remove(AssetPath) == 0)
+		{
+			continue;
+		}
+
+		const float* ManifestVolume = PendingManifestVolumes.Find(AssetPath);
+
+		UObject* Asset = AssetPath.ResolveObject();
+		if (USoundClass* SoundClass = Cast<USoundClass>(Asset))
+		{
+			RegisterSoundClass(SoundClass, ManifestVolume ? *ManifestVolume : SoundClass->Properties.Volume);
+		}
+		else if (USoundSubmix* SoundSubmix = Cast<USoundSubmix>(Asset))
+		{
+			RegisterSoundSubmix(SoundSubmix, ManifestVolume ? *ManifestVolume : SoundSubmix->OutputVolume);
+		}
+		else if (ManifestVolume)
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Failed to load manifest entry %s; the manifest is likely stale. Re-run the SoundClassMixerManifest commandlet before packaging."), *AssetPath.ToString());
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Failed to load %s."), *AssetPath.ToString());
+		}
 	}
-	
-	AdjustVolumeDuration = FMath::Max(0.0f, AdjustVolumeDuration);
-	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
-	
-	if (FMath::IsNearlyZero(AdjustVolumeDuration))
+
+	if (PendingAssetPaths.Num() == 0)
 	{
-		SetSoundClassVolumeInternal(SoundClassAsset, AdjustVolumeLevel);
-		return;
+		OnGatherCompleted();
 	}
+}
 
-	FSoundSubSysProperties* FoundSoundClassProps = SoundClassMap.Find(SoundClassAsset);
-	check(FoundSoundClassProps);
+void USoundClassMixerSubsystem::OnGatherCompleted()
+{
+	StreamableHandles.Reset();
+	PendingManifestVolumes.Reset();
 
-	if (IsInAudioThread())
+	// Anything still deferred targets an asset that never registered.
+	if (DeferredCommands.Num() > 0)
 	{
-		FoundSoundClassProps->Fader.StartFade(
-			AdjustVolumeLevel,
-			AdjustVolumeDuration,
-			static_cast<Audio::EFaderCurve>(FadeCurve)
-		);
-		return;
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Dropping %d mixer commands for assets that failed to load."), DeferredCommands.Num());
+		for (const FSoundClassMixerCommand& Command : DeferredCommands)
+		{
+			ReleaseCommandEnvelope(Command);
+		}
+		DeferredCommands.Reset();
 	}
 
-	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.SoundClass.AdjustVolume"), STAT_SoundClassAdjustVolume, STATGROUP_AudioThreadCommands);
-	FAudioThread::RunCommandOnAudioThread(
-		[FoundSoundClassProps, AdjustVolumeDuration, AdjustVolumeLevel, FadeCurve]
-		{
-			FoundSoundClassProps->Fader.StartFade(
-				AdjustVolumeLevel,
-				AdjustVolumeDuration,
-				static_cast<Audio::EFaderCurve>(FadeCurve)
-			);
-		},
-		GET_STATID(STAT_SoundClassAdjustVolume)
-	);
+	RebuildSoundClassHierarchy();
+
+	UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Gathered %d SoundClasses and %d SoundSubmixes."), SoundClassMap.Num(), SoundSubmixMap.Num());
+	OnReady.Broadcast();
 }
 
-USoundClass* USoundClassMixerSubsystem::FindSoundClassByName(const FString& SoundClassName)
+void USoundClassMixerSubsystem::FlushDeferredCommands(const UObject* Asset)
 {
-	for (auto It = SoundClassMap.CreateIterator(); It; ++It)
+	for (int32 Index = 0; Index < DeferredCommands.Num();)
 	{
-		if (It->Key->GetName() == SoundClassName)
+		if (DeferredCommands[Index].Target == Asset)
 		{
-			return It->Key;
+			FSoundClassMixerCommand Command = DeferredCommands[Index];
+			DeferredCommands.RemoveAt(Index, 1, false);
+
+			Command.Channel = Command.TargetType == ESoundClassMixerTargetType::SoundClass
+				? GetSoundClassChannel(static_cast<const USoundClass*>(Asset))
+				: GetSoundSubmixChannel(static_cast<const USoundSubmix*>(Asset));
+			EnqueueCommand(Command);
+			continue;
 		}
+		++Index;
 	}
-
-	return nullptr;
 }
 
-// =====================================================================================================================
+void USoundClassMixerSubsystem::RegisterSoundClass(USoundClass* SoundClassAsset)
+{
+	RegisterSoundClass(SoundClassAsset, SoundClassAsset->Properties.Volume);
+}
 
-void USoundClassMixerSubsystem::SetSoundSubmixVolumeInternal(
-	const USoundSubmix* SoundSubmixAsset,
-	float AdjustVolumeLevel
-)
+void USoundClassMixerSubsystem::RegisterSoundClass(USoundClass* SoundClassAsset, const float InitialVolume)
 {
-	if (!SoundSubmixAsset)
+	check(IsInGameThread());
+
+	UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Added SoundClass: %s"), *SoundClassAsset->GetName());
+	if (DeviceSoundMix && SoundClassAsset->Properties.Volume <= KINDA_SMALL_NUMBER)
 	{
-		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
-		return;
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("SoundClass %s is authored silent; device-scoped volumes only scale the authored volume and can't raise it."),
+			*SoundClassAsset->GetName());
+	}
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		const int32 ChannelIndex = AllocateChannel(SoundClassAsset, ESoundClassMixerTargetType::SoundClass, InitialVolume);
+		SoundClassMap.Add(SoundClassAsset, ChannelIndex);
 	}
 
-	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
-
-	FSoundSubSysProperties* FoundSoundSubmixProps = SoundSubmixMap.Find(SoundSubmixAsset);
-	check(FoundSoundSubmixProps);
+	// Queued ahead of the deferred commands so they still land last.
+	if (!FMath::IsNearlyEqual(SoundClassAsset->Properties.Volume, InitialVolume))
+	{
+		SetSoundClassVolumeInternal(SoundClassAsset, InitialVolume);
+	}
+	FlushDeferredCommands(SoundClassAsset);
 
-	if (IsInAudioThread())
+	USoundClass*& IndexedSoundClass = SoundClassNameIndex.FindOrAdd(SoundClassAsset->GetFName());
+	if (IndexedSoundClass && IndexedSoundClass != SoundClassAsset)
 	{
-		FoundSoundSubmixProps->bIsFading = false;
-		FoundSoundSubmixProps->Fader.SetVolume(AdjustVolumeLevel);
-		ApplySubmixVolume(SoundSubmixAsset, AdjustVolumeLevel);
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("SoundClass name %s is ambiguous, lookups by name resolve to %s."),
+			*SoundClassAsset->GetName(), *IndexedSoundClass->GetPathName());
 		return;
 	}
+	IndexedSoundClass = SoundClassAsset;
+}
 
-	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.SoundSubmix.SetVolume"), STAT_SoundSubmixAdjustVolume, STATGROUP_AudioThreadCommands);
-	FAudioThread::RunCommandOnAudioThread(
-		[FoundSoundSubmixProps, SoundSubmixAsset, AdjustVolumeLevel, this]
-		{
-			FoundSoundSubmixProps->bIsFading = false;
-			FoundSoundSubmixProps->Fader.SetVolume(AdjustVolumeLevel);
-			ApplySubmixVolume(SoundSubmixAsset, AdjustVolumeLevel);
-		},
-		GET_STATID(STAT_SoundSubmixAdjustVolume)
-	);
+void USoundClassMixerSubsystem::RegisterSoundSubmix(USoundSubmix* SoundSubmixAsset)
+{
+	RegisterSoundSubmix(SoundSubmixAsset, SoundSubmixAsset->OutputVolume);
 }
 
-void USoundClassMixerSubsystem::AdjustSoundSubmixVolumeInternal(
-	const USoundSubmix* SoundSubmixAsset,
-	float AdjustVolumeDuration, float AdjustVolumeLevel,
-	const bool bInIsFadeOut, const EAudioFaderCurve FadeCurve
-)
+void USoundClassMixerSubsystem::RegisterSoundSubmix(USoundSubmix* SoundSubmixAsset, const float InitialVolume)
 {
-	if (!SoundSubmixAsset)
+	check(IsInGameThread());
+
+	UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Added SoundSubmix: %s"), *SoundSubmixAsset->GetName());
 	{
-		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
-		return;
+		FScopeLock Lock(&AudioStateCriticalSection);
+		const int32 ChannelIndex = AllocateChannel(SoundSubmixAsset, ESoundClassMixerTargetType::SoundSubmix, InitialVolume);
+		SoundSubmixMap.Add(SoundSubmixAsset, ChannelIndex);
 	}
-	
-	AdjustVolumeDuration = FMath::Max(0.0f, AdjustVolumeDuration);
-	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
 
-	if (FMath::IsNearlyZero(AdjustVolumeDuration))
+	if (!FMath::IsNearlyEqual(SoundSubmixAsset->OutputVolume, InitialVolume))
 	{
-		SetSoundSubmixVolumeInternal(SoundSubmixAsset, AdjustVolumeLevel);
-		return;
+		SetSoundSubmixVolumeInternal(SoundSubmixAsset, InitialVolume);
 	}
+	FlushDeferredCommands(SoundSubmixAsset);
 
-	FSoundSubSysProperties* FoundSoundSubmixProps = SoundSubmixMap.Find(SoundSubmixAsset);
-	check(FoundSoundSubmixProps);
-
-	if (IsInAudioThread())
+	USoundSubmix*& IndexedSoundSubmix = SoundSubmixNameIndex.FindOrAdd(SoundSubmixAsset->GetFName());
+	if (IndexedSoundSubmix && IndexedSoundSubmix != SoundSubmixAsset)
 	{
-		FoundSoundSubmixProps->bIsFading = bInIsFadeOut || FMath::IsNearlyZero(AdjustVolumeLevel);
-		FoundSoundSubmixProps->Fader.StartFade(
-			AdjustVolumeLevel,
-			AdjustVolumeDuration,
-			static_cast<Audio::EFaderCurve>(FadeCurve)
-		);
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("SoundSubmix name %s is ambiguous, lookups by name resolve to %s."),
+			*SoundSubmixAsset->GetName(), *IndexedSoundSubmix->GetPathName());
 		return;
 	}
-
-	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.SoundSubmix.AdjustVolume"), STAT_SoundSubmixAdjustVolume, STATGROUP_AudioThreadCommands);
-	FAudioThread::RunCommandOnAudioThread(
-		[FoundSoundSubmixProps, bInIsFadeOut, AdjustVolumeDuration, AdjustVolumeLevel, FadeCurve]
-		{
-			FoundSoundSubmixProps->bIsFading = bInIsFadeOut || FMath::IsNearlyZero(AdjustVolumeLevel);
-			FoundSoundSubmixProps->Fader.StartFade(
-				AdjustVolumeLevel,
-				AdjustVolumeDuration,
-				static_cast<Audio::EFaderCurve>(FadeCurve)
-			);
-		},
-		GET_STATID(STAT_SoundSubmixAdjustVolume)
-	);
+	IndexedSoundSubmix = SoundSubmixAsset;
 }
 
-USoundSubmix* USoundClassMixerSubsystem::FindSoundSubmixByName(const FString& SoundSubmixName)
+void USoundClassMixerSubsystem::RebuildSoundClassHierarchy()
 {
-	for (auto It = SoundSubmixMap.CreateIterator(); It; ++It)
-	{
-		if (It->Key->GetName() == SoundSubmixName)
-		{
-			return It->Key;
-		}
-	}
+	check(IsInGameThread());
 
-	return nullptr;
-}
+	FScopeLock Lock(&AudioStateCriticalSection);
 
-// =====================================================================================================================
+	SoundClassHierarchy.Reset(SoundClassMap.Num());
+	EffectiveSoundClassVolumes.Reset(SoundClassMap.Num());
 
-void USoundClassMixerSubsystem::ApplySubmixVolume(const USoundSubmix* SoundSubmixAsset, float Volume)
+	TMap<int32, TArray<int32>> ChildChannels;
+	TArray<TPair<int32, int32>> Stack;
+	TArray<float> BaseVolumes;
+	BaseVolumes.SetNumUninitialized(Channels.Num());
+	for (const TPair<USoundClass*, int32>& Pair : SoundClassMap)
+	{
+		Channels[Pair.Value].HierarchyIndex = INDEX_NONE;
+
+		// Unmanaged classes in between have no channel to propagate from; fold them in here instead.
+		const int32* ParentChannel = nullptr;
+		float& BaseVolume = BaseVolumes[Pair.Value];
+		BaseVolume = 1.0f;
+		for (const USoundClass* Ancestor = Pair.Key->ParentClass; Ancestor; Ancestor = Ancestor->ParentClass)
+		{
+			ParentChannel = SoundClassMap.Find(Ancestor);
+			if (ParentChannel)
+			{
+				break;
+			}
+			BaseVolume *= Ancestor->Properties.Volume;
+		}
+
+		if (ParentChannel)
+		{
+			ChildChannels.FindOrAdd(*ParentChannel).Add(Pair.Value);
+		}
+		else
+		{
+			Stack.Emplace(Pair.Value, INDEX_NONE);
+		}
+	}
+
+	// Depth first with an explicit stack: children are emitted right after their parent, before any sibling subtree.
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Entry = Stack.Pop(false);
+
+		const int32 NodeIndex = SoundClassHierarchy.AddDefaulted();
+		FSoundClassHierarchyNode& Node = SoundClassHierarchy[NodeIndex];
+		Node.Channel    = Entry.Key;
+		Node.Parent     = Entry.Value;
+		Node.SubtreeEnd = NodeIndex + 1;
+		Node.BaseVolume = BaseVolumes[Entry.Key];
+		Channels[Entry.Key].HierarchyIndex = NodeIndex;
+
+		if (const TArray<int32>* Children = ChildChannels.Find(Entry.Key))
+		{
+			for (const int32 ChildChannel : *Children)
+			{
+				Stack.Emplace(ChildChannel, NodeIndex);
+			}
+		}
+	}
+
+	for (int32 NodeIndex = SoundClassHierarchy.Num() - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		const FSoundClassHierarchyNode& Node = SoundClassHierarchy[NodeIndex];
+		if (Node.Parent != INDEX_NONE)
+		{
+			int32& ParentSubtreeEnd = SoundClassHierarchy[Node.Parent].SubtreeEnd;
+			ParentSubtreeEnd = FMath::Max(ParentSubtreeEnd, Node.SubtreeEnd);
+		}
+	}
+
+	EffectiveSoundClassVolumes.SetNumUninitialized(SoundClassHierarchy.Num());
+	PropagateSoundClassVolumes(0, SoundClassHierarchy.Num());
+}
+
+void USoundClassMixerSubsystem::PropagateSoundClassVolumes(const int32 Begin, const int32 End)
+{
+	for (int32 NodeIndex = Begin; NodeIndex < End; ++NodeIndex)
+	{
+		const FSoundClassHierarchyNode& Node = SoundClassHierarchy[NodeIndex];
+		const float ParentVolume = Node.Parent != INDEX_NONE ? EffectiveSoundClassVolumes[Node.Parent] : 1.0f;
+		EffectiveSoundClassVolumes[NodeIndex] = ParentVolume * Node.BaseVolume * Channels[Node.Channel].Properties.Volume;
+	}
+}
+
+float USoundClassMixerSubsystem::GetEffectiveSoundClassVolume(const USoundClass* SoundClassAsset) const
+{
+	if (!SoundClassAsset)
+	{
+		return 0.0f;
+	}
+
+	// Channel volumes and the cached tree are written by the audio thread update.
+	FScopeLock Lock(&AudioStateCriticalSection);
+
+	const int32* ChannelIndex = SoundClassMap.Find(SoundClassAsset);
+	const int32 NodeIndex = ChannelIndex ? Channels[*ChannelIndex].HierarchyIndex : INDEX_NONE;
+	if (NodeIndex != INDEX_NONE)
+	{
+		return EffectiveSoundClassVolumes[NodeIndex];
+	}
+
+	// Not in the cached tree (unmanaged, or still streaming in): walk the parents instead.
+	float Volume = 1.0f;
+	for (const USoundClass* SoundClass = SoundClassAsset; SoundClass; SoundClass = SoundClass->ParentClass)
+	{
+		const int32* AncestorChannel = SoundClassMap.Find(SoundClass);
+		Volume *= AncestorChannel ? Channels[*AncestorChannel].Properties.Volume : SoundClass->Properties.Volume;
+	}
+	return Volume;
+}
+
+int32 USoundClassMixerSubsystem::AllocateChannel(UObject* Target, const ESoundClassMixerTargetType TargetType, const float InitialVolume)
+{
+	check(IsInGameThread());
+
+	const int32 ChannelIndex = FreeChannels.Num() > 0 ? FreeChannels.Pop(false) : Channels.AddDefaulted();
+
+	FSoundClassMixerChannel& Channel = Channels[ChannelIndex];
+	Channel.Target     = Target;
+	Channel.TargetType = TargetType;
+	Channel.Properties = FSoundSubSysProperties();
+	Channel.Properties.Fader.SetVolume(InitialVolume);
+	Channel.Properties.Volume = InitialVolume;
+	Channel.HierarchyIndex = INDEX_NONE;
+	FaderBank.Remove(ChannelIndex);
+
+	// Generation 0 is reserved for default constructed handles.
+	++Channel.Generation;
+	return ChannelIndex;
+}
+
+void USoundClassMixerSubsystem::ReleaseAllChannels()
+{
+	check(IsInGameThread());
+
+	FreeChannels.Reset();
+	for (int32 ChannelIndex = Channels.Num() - 1; ChannelIndex >= 0; --ChannelIndex)
+	{
+		FSoundClassMixerChannel& Channel = Channels[ChannelIndex];
+		if (Channel.Target)
+		{
+			Channel.Target = nullptr;
+			++Channel.Generation;
+		}
+		FreeChannels.Add(ChannelIndex);
+	}
+
+	SoundClassMap.Empty();
+	SoundSubmixMap.Empty();
+	SoundClassHierarchy.Reset();
+	EffectiveSoundClassVolumes.Reset();
+	FaderBank.Reset();
+
+	// Duck faders were reset with their channels; re-resolve whatever is still pushed against the new ones.
+	ResolvedDucks.Reset();
+	bDucksDirty = ActiveDucks.Num() > 0;
+}
+
+FMixerChannelHandle USoundClassMixerSubsystem::GetSoundClassChannel(const USoundClass* SoundClassAsset) const
+{
+	FMixerChannelHandle Handle;
+	if (const int32* ChannelIndex = SoundClassMap.Find(SoundClassAsset))
+	{
+		Handle.Index      = *ChannelIndex;
+		Handle.Generation = Channels[*ChannelIndex].Generation;
+	}
+	return Handle;
+}
+
+FMixerChannelHandle USoundClassMixerSubsystem::GetSoundSubmixChannel(const USoundSubmix* SoundSubmixAsset) const
+{
+	FMixerChannelHandle Handle;
+	if (const int32* ChannelIndex = SoundSubmixMap.Find(SoundSubmixAsset))
+	{
+		Handle.Index      = *ChannelIndex;
+		Handle.Generation = Channels[*ChannelIndex].Generation;
+	}
+	return Handle;
+}
+
+bool USoundClassMixerSubsystem::IsChannelValid(const FMixerChannelHandle Channel) const
+{
+	return Channels.IsValidIndex(Channel.Index)
+		&& Channels[Channel.Index].Generation == Channel.Generation
+		&& Channels[Channel.Index].Target != nullptr;
+}
+
+const FSoundSubSysProperties* USoundClassMixerSubsystem::FindSoundClassProperties(const USoundClass* SoundClassAsset) const
+{
+	const int32* ChannelIndex = SoundClassMap.Find(SoundClassAsset);
+	return ChannelIndex ? &Channels[*ChannelIndex].Properties : nullptr;
+}
+
+const FSoundSubSysProperties* USoundClassMixerSubsystem::FindSoundSubmixProperties(const USoundSubmix* SoundSubmixAsset) const
+{
+	const int32* ChannelIndex = SoundSubmixMap.Find(SoundSubmixAsset);
+	return ChannelIndex ? &Channels[*ChannelIndex].Properties : nullptr;
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::SetSoundClassVolumeInternal(
+	const USoundClass* SoundClassAsset,
+	float AdjustVolumeLevel
+)
+{
+	if (!SoundClassAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundClassChannel(SoundClassAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundClassAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::SetVolume;
+	Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+	Command.Target     = const_cast<USoundClass*>(SoundClassAsset);
+	Command.Channel    = Channel;
+	Command.Volume     = FMath::Max(0.0f, AdjustVolumeLevel);
+	EnqueueCommand(Command);
+}
+
+
+void USoundClassMixerSubsystem::AdjustSoundClassVolumeInternal(
+	const USoundClass* SoundClassAsset,
+	float AdjustVolumeDuration, float AdjustVolumeLevel,
+	const bool bInIsFadeOut, const EAudioFaderCurve FadeCurve
+)
+{
+	if (!SoundClassAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
+		return;
+	}
+	
+	AdjustVolumeDuration = FMath::Max(0.0f, AdjustVolumeDuration);
+	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
+	
+	if (FMath::IsNearlyZero(AdjustVolumeDuration))
+	{
+		SetSoundClassVolumeInternal(SoundClassAsset, AdjustVolumeLevel);
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundClassChannel(SoundClassAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundClassAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StartFade;
+	Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+	Command.Target     = const_cast<USoundClass*>(SoundClassAsset);
+	Command.Channel    = Channel;
+	Command.Volume     = AdjustVolumeLevel;
+	Command.Duration   = AdjustVolumeDuration;
+	Command.Curve      = static_cast<Audio::EFaderCurve>(FadeCurve);
+	Command.bIsFadeOut = bInIsFadeOut;
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::StopSoundClassFadeInternal(const USoundClass* SoundClassAsset)
+{
+	if (!SoundClassAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Class is invalid."))
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundClassChannel(SoundClassAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundClassAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StopFade;
+	Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+	Command.Target     = const_cast<USoundClass*>(SoundClassAsset);
+	Command.Channel    = Channel;
+	EnqueueCommand(Command);
+}
+
+USoundClass* USoundClassMixerSubsystem::FindSoundClassByName(const FString& SoundClassName) const
+{
+	// FNAME_Find doesn't grow the name table; an unknown name can't belong to a registered asset.
+	return FindSoundClassByName(FName(*SoundClassName, FNAME_Find));
+}
+
+USoundClass* USoundClassMixerSubsystem::FindSoundClassByName(const FName SoundClassName) const
+{
+	if (SoundClassName.IsNone())
+	{
+		return nullptr;
+	}
+
+	USoundClass* const* FoundSoundClass = SoundClassNameIndex.Find(SoundClassName);
+	return FoundSoundClass ? *FoundSoundClass : nullptr;
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::SetSoundSubmixVolumeInternal(
+	const USoundSubmix* SoundSubmixAsset,
+	float AdjustVolumeLevel
+)
+{
+	if (!SoundSubmixAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundSubmixChannel(SoundSubmixAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundSubmixAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::SetVolume;
+	Command.TargetType = ESoundClassMixerTargetType::SoundSubmix;
+	Command.Target     = const_cast<USoundSubmix*>(SoundSubmixAsset);
+	Command.Channel    = Channel;
+	Command.Volume     = FMath::Max(0.0f, AdjustVolumeLevel);
+	Command.RenderFadeId = PushSubmixFaderSettings(SoundSubmixAsset, Command.Volume, 0.0f, EAudioFaderCurve::Linear, false);
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::AdjustSoundSubmixVolumeInternal(
+	const USoundSubmix* SoundSubmixAsset,
+	float AdjustVolumeDuration, float AdjustVolumeLevel,
+	const bool bInIsFadeOut, const EAudioFaderCurve FadeCurve
+)
+{
+	if (!SoundSubmixAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
+		return;
+	}
+	
+	AdjustVolumeDuration = FMath::Max(0.0f, AdjustVolumeDuration);
+	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
+
+	if (FMath::IsNearlyZero(AdjustVolumeDuration))
+	{
+		SetSoundSubmixVolumeInternal(SoundSubmixAsset, AdjustVolumeLevel);
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundSubmixChannel(SoundSubmixAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundSubmixAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StartFade;
+	Command.TargetType = ESoundClassMixerTargetType::SoundSubmix;
+	Command.Target     = const_cast<USoundSubmix*>(SoundSubmixAsset);
+	Command.Channel    = Channel;
+	Command.Volume     = AdjustVolumeLevel;
+	Command.Duration   = AdjustVolumeDuration;
+	Command.Curve      = static_cast<Audio::EFaderCurve>(FadeCurve);
+	Command.bIsFadeOut = bInIsFadeOut;
+	Command.RenderFadeId = PushSubmixFaderSettings(SoundSubmixAsset, AdjustVolumeLevel, AdjustVolumeDuration, FadeCurve, false);
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::StopSoundSubmixFadeInternal(const USoundSubmix* SoundSubmixAsset)
+{
+	if (!SoundSubmixAsset)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Sound Submix is invalid."))
+		return;
+	}
+
+	const FMixerChannelHandle Channel = GetSoundSubmixChannel(SoundSubmixAsset);
+	check(Channel.IsSet() || IsAssetPending(SoundSubmixAsset));
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StopFade;
+	Command.TargetType = ESoundClassMixerTargetType::SoundSubmix;
+	Command.Target     = const_cast<USoundSubmix*>(SoundSubmixAsset);
+	Command.Channel    = Channel;
+	Command.RenderFadeId = PushSubmixFaderSettings(SoundSubmixAsset, 0.0f, 0.0f, EAudioFaderCurve::Linear, true);
+	EnqueueCommand(Command);
+}
+
+USoundSubmix* USoundClassMixerSubsystem::FindSoundSubmixByName(const FString& SoundSubmixName) const
+{
+	return FindSoundSubmixByName(FName(*SoundSubmixName, FNAME_Find));
+}
+
+USoundSubmix* USoundClassMixerSubsystem::FindSoundSubmixByName(const FName SoundSubmixName) const
+{
+	if (SoundSubmixName.IsNone())
+	{
+		return nullptr;
+	}
+
+	USoundSubmix* const* FoundSoundSubmix = SoundSubmixNameIndex.Find(SoundSubmixName);
+	return FoundSoundSubmix ? *FoundSoundSubmix : nullptr;
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::SetChannelVolumeInternal(const FMixerChannelHandle Channel, const float AdjustVolumeLevel)
+{
+	if (!IsChannelValid(Channel))
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Ignoring stale mixer channel handle (%d, %d)."), Channel.Index, Channel.Generation)
+		return;
+	}
+
+	const FSoundClassMixerChannel& ChannelData = Channels[Channel.Index];
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::SetVolume;
+	Command.TargetType = ChannelData.TargetType;
+	Command.Target     = ChannelData.Target;
+	Command.Channel    = Channel;
+	Command.Volume     = FMath::Max(0.0f, AdjustVolumeLevel);
+	Command.RenderFadeId = ChannelData.TargetType == ESoundClassMixerTargetType::SoundSubmix
+		? PushSubmixFaderSettings(static_cast<const USoundSubmix*>(ChannelData.Target), Command.Volume, 0.0f, EAudioFaderCurve::Linear, false)
+		: 0;
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::AdjustChannelVolumeInternal(
+	const FMixerChannelHandle Channel,
+	float AdjustVolumeDuration, float AdjustVolumeLevel,
+	const EAudioFaderCurve FadeCurve
+)
+{
+	if (!IsChannelValid(Channel))
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Ignoring stale mixer channel handle (%d, %d)."), Channel.Index, Channel.Generation)
+		return;
+	}
+
+	const FSoundClassMixerChannel& ChannelData = Channels[Channel.Index];
+	AdjustVolumeDuration = FMath::Max(0.0f, AdjustVolumeDuration);
+	AdjustVolumeLevel = FMath::Max(0.0f, AdjustVolumeLevel);
+
+	if (FMath::IsNearlyZero(AdjustVolumeDuration))
+	{
+		SetChannelVolumeInternal(Channel, AdjustVolumeLevel);
+		return;
+	}
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StartFade;
+	Command.TargetType = ChannelData.TargetType;
+	Command.Target     = ChannelData.Target;
+	Command.Channel    = Channel;
+	Command.Volume     = AdjustVolumeLevel;
+	Command.Duration   = AdjustVolumeDuration;
+	Command.Curve      = static_cast<Audio::EFaderCurve>(FadeCurve);
+	Command.bIsFadeOut = GetChannelVolumeInternal(Channel) > AdjustVolumeLevel;
+	Command.RenderFadeId = ChannelData.TargetType == ESoundClassMixerTargetType::SoundSubmix
+		? PushSubmixFaderSettings(static_cast<const USoundSubmix*>(ChannelData.Target), AdjustVolumeLevel, AdjustVolumeDuration, FadeCurve, false)
+		: 0;
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::StopChannelFadeInternal(const FMixerChannelHandle Channel)
+{
+	if (!IsChannelValid(Channel))
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Ignoring stale mixer channel handle (%d, %d)."), Channel.Index, Channel.Generation)
+		return;
+	}
+
+	const FSoundClassMixerChannel& ChannelData = Channels[Channel.Index];
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StopFade;
+	Command.TargetType = ChannelData.TargetType;
+	Command.Target     = ChannelData.Target;
+	Command.Channel    = Channel;
+	Command.RenderFadeId = ChannelData.TargetType == ESoundClassMixerTargetType::SoundSubmix
+		? PushSubmixFaderSettings(static_cast<const USoundSubmix*>(ChannelData.Target), 0.0f, 0.0f, EAudioFaderCurve::Linear, true)
+		: 0;
+	EnqueueCommand(Command);
+}
+
+float USoundClassMixerSubsystem::GetChannelVolumeInternal(const FMixerChannelHandle Channel) const
+{
+	if (!IsChannelValid(Channel))
+	{
+		return 0.0f;
+	}
+
+	// Written by the audio thread update.
+	FScopeLock Lock(&AudioStateCriticalSection);
+
+	const FSoundSubSysProperties& Properties = Channels[Channel.Index].Properties;
+	if (Properties.bFaderOnRenderThread && Properties.RenderFaderState)
+	{
+		// The fader effect's ramp isn't mirrored per update; read the gain it last rendered.
+		return Properties.RenderFaderState->Gain.load(std::memory_order_relaxed) * Properties.DuckFader.GetVolume() * Properties.SidechainGain;
+	}
+
+	return Properties.Volume;
+}
+
+float USoundClassMixerSubsystem::GetSoundClassVolumeInternal(const USoundClass* SoundClassAsset) const
+{
+	// In device-scoped mode the asset keeps its authored volume, only the channel tracks the mix.
+	const FMixerChannelHandle Channel = GetSoundClassChannel(SoundClassAsset);
+	return IsChannelValid(Channel) ? GetChannelVolumeInternal(Channel) : SoundClassAsset->Properties.Volume;
+}
+
+float USoundClassMixerSubsystem::GetSoundSubmixVolumeInternal(const USoundSubmix* SoundSubmixAsset) const
+{
+	const FMixerChannelHandle Channel = GetSoundSubmixChannel(SoundSubmixAsset);
+	return IsChannelValid(Channel) ? GetChannelVolumeInternal(Channel) : SoundSubmixAsset->OutputVolume;
+}
+
+// =====================================================================================================================
+
+int32 USoundClassMixerSubsystem::PushDuck(const FSoundClassMixerDuckRequest& Request)
+{
+	check(IsInGameThread());
+
+	FSoundClassMixerActiveDuck Duck;
+	Duck.Gain        = FMath::Pow(10.0f, -FMath::Max(0.0f, Request.AttenuationDb) / 20.0f);
+	Duck.AttackTime  = FMath::Max(0.0f, Request.AttackTime);
+	Duck.ReleaseTime = FMath::Max(0.0f, Request.ReleaseTime);
+	Duck.Priority    = Request.Priority;
+	Duck.Curve       = static_cast<Audio::EFaderCurve>(Request.Curve);
+
+	for (const USoundClass* TargetClass : Request.TargetClasses)
+	{
+		const FMixerChannelHandle Channel = GetSoundClassChannel(TargetClass);
+		if (!Channel.IsSet())
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Duck from %s: skipping unmanaged Sound Class %s."),
+				*GetNameSafe(Request.SourceClass), *GetNameSafe(TargetClass))
+			continue;
+		}
+		Duck.Targets.Add(Channel);
+	}
+
+	const int32 DuckId = ++LastDuckId;
+	ActiveDucks.Add(DuckId, MoveTemp(Duck));
+
+	bDucksDirty = true;
+	bHasPendingWork = true;
+	return DuckId;
+}
+
+void USoundClassMixerSubsystem::ReleaseDuck(const int32 DuckId)
+{
+	check(IsInGameThread());
+
+	if (ActiveDucks.Remove(DuckId) > 0)
+	{
+		bDucksDirty = true;
+		bHasPendingWork = true;
+	}
+}
+
+void USoundClassMixerSubsystem::ResolveDucks()
+{
+	check(IsInGameThread());
+
+	bDucksDirty = false;
+
+	const ESoundClassMixerDuckPolicy Policy = GetDefault<USoundClassMixerSettings>()->DuckPolicy;
+	const auto Wins = [Policy](const FSoundClassMixerActiveDuck& Candidate, const FSoundClassMixerResolvedDuck& Current)
+	{
+		switch (Policy)
+		{
+			case ESoundClassMixerDuckPolicy::Deepest:
+				return Candidate.Gain < Current.Gain;
+
+			case ESoundClassMixerDuckPolicy::Shallowest:
+				return Candidate.Gain > Current.Gain;
+
+			case ESoundClassMixerDuckPolicy::Priority:
+			default:
+				return Candidate.Priority > Current.Priority
+					|| (Candidate.Priority == Current.Priority && Candidate.Gain < Current.Gain);
+		}
+	};
+
+	// One pass over every request and target.
+	TMap<int32, FSoundClassMixerResolvedDuck> Resolved;
+	Resolved.Reserve(ResolvedDucks.Num());
+	for (const TPair<int32, FSoundClassMixerActiveDuck>& Pair : ActiveDucks)
+	{
+		const FSoundClassMixerActiveDuck& Duck = Pair.Value;
+		for (const FMixerChannelHandle Channel : Duck.Targets)
+		{
+			if (!IsChannelValid(Channel))
+			{
+				continue;
+			}
+
+			FSoundClassMixerResolvedDuck* Current = Resolved.Find(Channel.Index);
+			if (Current && !Wins(Duck, *Current))
+			{
+				continue;
+			}
+
+			FSoundClassMixerResolvedDuck& Winner = Current ? *Current : Resolved.Add(Channel.Index);
+			Winner.Channel     = Channel;
+			Winner.Gain        = Duck.Gain;
+			Winner.AttackTime  = Duck.AttackTime;
+			Winner.ReleaseTime = Duck.ReleaseTime;
+			Winner.Priority    = Duck.Priority;
+			Winner.Curve       = Duck.Curve;
+		}
+	}
+
+	// Only channels whose winning gain changed get a command.
+	TArray<FSoundClassMixerCommand, TInlineAllocator<32>> Commands;
+	for (const TPair<int32, FSoundClassMixerResolvedDuck>& Pair : Resolved)
+	{
+		const FSoundClassMixerResolvedDuck* Previous = ResolvedDucks.Find(Pair.Key);
+		if (Previous && FMath::IsNearlyEqual(Previous->Gain, Pair.Value.Gain))
+		{
+			continue;
+		}
+
+		// Deeper than before attacks, shallower releases.
+		const bool bIsAttack = !Previous || Pair.Value.Gain < Previous->Gain;
+		FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+		Command.Type       = ESoundClassMixerCommandType::StartDuck;
+		Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+		Command.Target     = Channels[Pair.Key].Target;
+		Command.Channel    = Pair.Value.Channel;
+		Command.Volume     = Pair.Value.Gain;
+		Command.Duration   = bIsAttack ? Pair.Value.AttackTime : Previous->ReleaseTime;
+		Command.Curve      = Pair.Value.Curve;
+	}
+
+	for (const TPair<int32, FSoundClassMixerResolvedDuck>& Pair : ResolvedDucks)
+	{
+		if (Resolved.Contains(Pair.Key) || !IsChannelValid(Pair.Value.Channel))
+		{
+			continue;
+		}
+
+		FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+		Command.Type       = ESoundClassMixerCommandType::StartDuck;
+		Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+		Command.Target     = Channels[Pair.Key].Target;
+		Command.Channel    = Pair.Value.Channel;
+		Command.Volume     = 1.0f;
+		Command.Duration   = Pair.Value.ReleaseTime;
+		Command.Curve      = Pair.Value.Curve;
+	}
+
+	ResolvedDucks = MoveTemp(Resolved);
+	EnqueueCommands(Commands);
+}
+
+// =====================================================================================================================
+
+int32 USoundClassMixerSubsystem::AddSidechain(const FSoundClassMixerSidechainSettings& Settings)
+{
+	check(IsInGameThread());
+
+	// Same device the volumes are applied to, so the listener and its targets can't end up on different ones.
+	SyncAudioDevice();
+	FAudioDevice* AudioDevice = GetMixerAudioDevice();
+	if (!Settings.SourceSubmix || !AudioDevice)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Sidechain needs a source submix and an audio device."))
+		return INDEX_NONE;
+	}
+
+	FSoundClassMixerActiveSidechain Sidechain;
+	Sidechain.Listener     = MakeShared<FSoundClassMixerSidechain, ESPMode::ThreadSafe>(Settings);
+	Sidechain.SourceSubmix = Settings.SourceSubmix;
+
+	for (const USoundClass* TargetClass : Settings.TargetClasses)
+	{
+		const FMixerChannelHandle Channel = GetSoundClassChannel(TargetClass);
+		if (Channel.IsSet())
+		{
+			Sidechain.Targets.Add(Channel);
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Sidechain target %s isn't managed by the mixer, skipped."), *GetNameSafe(TargetClass));
+		}
+	}
+	for (const USoundSubmix* TargetSubmix : Settings.TargetSubmixes)
+	{
+		const FMixerChannelHandle Channel = GetSoundSubmixChannel(TargetSubmix);
+		if (Channel.IsSet())
+		{
+			Sidechain.Targets.Add(Channel);
+		}
+		else
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Sidechain target %s isn't managed by the mixer, skipped."), *GetNameSafe(TargetSubmix));
+		}
+	}
+
+	if (Sidechain.Targets.Num() == 0)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Sidechain on %s has no managed targets."), *Settings.SourceSubmix->GetName());
+		return INDEX_NONE;
+	}
+
+	AudioDevice->RegisterSubmixBufferListener(Sidechain.Listener.Get(), Settings.SourceSubmix);
+
+	const int32 SidechainId = ++LastSidechainId;
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		Sidechains.Add(SidechainId, MoveTemp(Sidechain));
+	}
+
+	// Polled by every update from now on.
+	bHasPendingWork = true;
+
+	return SidechainId;
+}
+
+void USoundClassMixerSubsystem::RemoveSidechain(const int32 SidechainId)
+{
+	check(IsInGameThread());
+
+	FSoundClassMixerActiveSidechain Sidechain;
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		if (!Sidechains.RemoveAndCopyValue(SidechainId, Sidechain))
+		{
+			return;
+		}
+	}
+
+	// Deinitialize keeps the device the mixer last applied to, the world may already be gone.
+	if (bInitialized)
+	{
+		SyncAudioDevice();
+	}
+	if (FAudioDevice* AudioDevice = GetMixerAudioDevice())
+	{
+		AudioDevice->UnregisterSubmixBufferListener(Sidechain.Listener.Get(), Sidechain.SourceSubmix.Get());
+
+		// The submix drops the listener on the audio thread, under the same lock it holds while calling it from the
+		// render thread. A command queued behind that removal holds the last reference, so the listener is freed only
+		// once no buffer can reach it anymore; without an audio thread both run right here.
+		DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.ReleaseSidechain"), STAT_SoundClassMixerReleaseSidechain, STATGROUP_AudioThreadCommands);
+		FAudioThread::RunCommandOnAudioThread(
+			[Listener = MoveTemp(Sidechain.Listener)]() mutable
+			{
+				Listener.Reset();
+			},
+			GET_STATID(STAT_SoundClassMixerReleaseSidechain)
+		);
+	}
+
+	// The next update returns the targets' sidechain gain to 1.
+	bHasPendingWork = true;
+}
+
+void USoundClassMixerSubsystem::RemoveAllSidechains()
+{
+	TArray<int32> SidechainIds;
+	Sidechains.GetKeys(SidechainIds);
+	for (const int32 SidechainId : SidechainIds)
+	{
+		RemoveSidechain(SidechainId);
+	}
+}
+
+void USoundClassMixerSubsystem::ApplySidechainGains(const float SubmixVolumeEpsilon, uint32& NumDeviceCallsSkipped)
+{
+	check(IsInAudioThread());
+
+	if (Sidechains.Num() == 0 && SidechainChannels.Num() == 0)
+	{
+		return;
+	}
+
+	// Channels that were sidechained last update start at 1, so removed sidechains release their targets.
+	SidechainGainScratch.Reset();
+	for (const int32 ChannelIndex : SidechainChannels)
+	{
+		SidechainGainScratch.Add(ChannelIndex, 1.0f);
+	}
+
+	for (const TPair<int32, FSoundClassMixerActiveSidechain>& Pair : Sidechains)
+	{
+		const float Gain = Pair.Value.Listener->GetGain();
+		for (const FMixerChannelHandle Channel : Pair.Value.Targets)
+		{
+			if (!IsChannelValid(Channel))
+			{
+				continue;
+			}
+
+			float* ChannelGain = SidechainGainScratch.Find(Channel.Index);
+			if (!ChannelGain)
+			{
+				ChannelGain = &SidechainGainScratch.Add(Channel.Index, 1.0f);
+			}
+			*ChannelGain *= Gain;
+		}
+	}
+
+	SidechainChannels.Reset();
+	for (const TPair<int32, float>& Pair : SidechainGainScratch)
+	{
+		FSoundClassMixerChannel& Channel = Channels[Pair.Key];
+		if (!Channel.Target)
+		{
+			continue;
+		}
+
+		// Applied here, settled channels aren't visited by the fader update.
+		if (!FMath::IsNearlyEqual(Channel.Properties.SidechainGain, Pair.Value, 1.e-4f))
+		{
+			Channel.Properties.SidechainGain = Pair.Value;
+
+			const FSimpleFader& Fader = Channel.Properties.Fader;
+			const float FaderVolume = Channel.Properties.bFaderOnRenderThread
+				? Fader.GetVolumeAfterTime(Fader.GetFadeDuration())
+				: Fader.GetVolume();
+			ApplyChannelVolume(Channel, FaderVolume, Pair.Value == 1.0f, SubmixVolumeEpsilon, NumDeviceCallsSkipped);
+		}
+
+		if (!FMath::IsNearlyEqual(Pair.Value, 1.0f))
+		{
+			SidechainChannels.Add(Pair.Key);
+		}
+	}
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::RunEnvelopeInternal(
+	UObject* Target, const ESoundClassMixerTargetType TargetType,
+	const FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope
+)
+{
+	check(Channel.IsSet() || IsAssetPending(Target));
+
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> BakedEnvelope = FindOrBakeEnvelope(Envelope);
+	if (!BakedEnvelope)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Ignoring empty envelope for %s."), *GetNameSafe(Target))
+		return;
+	}
+
+	FSoundClassMixerCommand Command;
+	Command.Type       = ESoundClassMixerCommandType::StartEnvelope;
+	Command.TargetType = TargetType;
+	Command.Target     = Target;
+	Command.Channel    = Channel;
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+
+		// Skips 0, which marks commands without an envelope.
+		if (++LastCommandEnvelopeId == 0)
+		{
+			++LastCommandEnvelopeId;
+		}
+		Command.EnvelopeId = LastCommandEnvelopeId;
+		CommandEnvelopes.Add(Command.EnvelopeId, MoveTemp(BakedEnvelope));
+	}
+
+	// Envelopes run on the audio thread; park a render thread fader at unity so the device stage carries them.
+	if (TargetType == ESoundClassMixerTargetType::SoundSubmix)
+	{
+		if (USoundClassMixerSubmixFaderPreset** Preset = SubmixFaderPresets.Find(static_cast<USoundSubmix*>(Target)))
+		{
+			FSoundClassMixerSubmixFaderSettings Settings;
+			Settings.InitialVolume = (*Preset)->Settings.InitialVolume;
+			Settings.TargetVolume  = 1.0f;
+			Settings.FadeId        = ++LastSubmixFadeId;
+			(*Preset)->SetSettings(Settings);
+		}
+	}
+
+	EnqueueCommand(Command);
+}
+
+void USoundClassMixerSubsystem::RunChannelEnvelopeInternal(const FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope)
+{
+	if (!IsChannelValid(Channel))
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Ignoring stale mixer channel handle (%d, %d)."), Channel.Index, Channel.Generation)
+		return;
+	}
+
+	const FSoundClassMixerChannel& ChannelData = Channels[Channel.Index];
+	RunEnvelopeInternal(ChannelData.Target, ChannelData.TargetType, Channel, Envelope);
+}
+
+TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> USoundClassMixerSubsystem::FindOrBakeEnvelope(const FSoundClassMixerEnvelope& Envelope)
+{
+	check(IsInGameThread());
+
+	++EnvelopeCacheClock;
+
+	if (Envelope.Curve)
+	{
+		if (FSoundClassMixerCachedEnvelope* CachedEnvelope = CurveEnvelopes.Find(Envelope.Curve))
+		{
+			CachedEnvelope->LastUsed = EnvelopeCacheClock;
+			return CachedEnvelope->Envelope;
+		}
+
+		FSoundClassMixerCachedEnvelope& NewEntry = CurveEnvelopes.Add(Envelope.Curve);
+		NewEntry.Envelope = MakeShared<FSimpleFaderEnvelope, ESPMode::ThreadSafe>(FSimpleFaderEnvelope::FromRichCurve(Envelope.Curve->FloatCurve, CurveEnvelopeSampleInterval));
+		NewEntry.LastUsed = EnvelopeCacheClock;
+
+		TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> NewEnvelope = NewEntry.Envelope;
+		TrimEnvelopeCache();
+		return NewEnvelope;
+	}
+
+	if (Envelope.Keys.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	TArray<FSimpleFaderEnvelopeKey> Keys;
+	Keys.Reserve(Envelope.Keys.Num());
+
+	uint32 KeysHash = 0;
+	for (const FSoundClassMixerEnvelopeKey& Key : Envelope.Keys)
+	{
+		Keys.Add({ Key.Time, Key.Volume, static_cast<Audio::EFaderCurve>(Key.Curve) });
+		KeysHash = HashCombine(KeysHash, HashCombine(GetTypeHash(Key.Time), HashCombine(GetTypeHash(Key.Volume), GetTypeHash(static_cast<uint8>(Key.Curve)))));
+	}
+
+	FSimpleFaderEnvelope BakedEnvelope(MoveTemp(Keys));
+
+	// Blueprints tend to rebuild the same literal keys per call, share the baked copy.
+	FSoundClassMixerCachedEnvelope* CachedEnvelope = KeyEnvelopes.Find(KeysHash);
+	if (CachedEnvelope && CachedEnvelope->Envelope->GetKeys().Num() == BakedEnvelope.GetKeys().Num())
+	{
+		bool bIsSame = true;
+		for (int32 Index = 0; bIsSame && Index < BakedEnvelope.GetKeys().Num(); ++Index)
+		{
+			const FSimpleFaderEnvelopeKey& A = CachedEnvelope->Envelope->GetKeys()[Index];
+			const FSimpleFaderEnvelopeKey& B = BakedEnvelope.GetKeys()[Index];
+			bIsSame = A.Time == B.Time && A.Volume == B.Volume && A.Curve == B.Curve;
+		}
+
+		if (bIsSame)
+		{
+			CachedEnvelope->LastUsed = EnvelopeCacheClock;
+			return CachedEnvelope->Envelope;
+		}
+	}
+
+	// A colliding key set replaces the cached one; faders running the old envelope keep their reference.
+	FSoundClassMixerCachedEnvelope& NewEntry = KeyEnvelopes.Add(KeysHash);
+	NewEntry.Envelope = MakeShared<FSimpleFaderEnvelope, ESPMode::ThreadSafe>(MoveTemp(BakedEnvelope));
+	NewEntry.LastUsed = EnvelopeCacheClock;
+
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> NewEnvelope = NewEntry.Envelope;
+	TrimEnvelopeCache();
+	return NewEnvelope;
+}
+
+void USoundClassMixerSubsystem::TrimEnvelopeCache()
+{
+	check(IsInGameThread());
+
+	// A collected curve can't be looked up again.
+	for (auto It = CurveEnvelopes.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Evictions are rare and the cache small, a scan for the oldest entry is enough.
+	while (CurveEnvelopes.Num() + KeyEnvelopes.Num() > MaxCachedEnvelopes)
+	{
+		const TWeakObjectPtr<UCurveFloat>* OldestCurve = nullptr;
+		const uint32* OldestKeysHash = nullptr;
+		uint64 OldestUsed = MAX_uint64;
+
+		for (const TPair<TWeakObjectPtr<UCurveFloat>, FSoundClassMixerCachedEnvelope>& Pair : CurveEnvelopes)
+		{
+			if (Pair.Value.LastUsed < OldestUsed)
+			{
+				OldestCurve = &Pair.Key;
+				OldestKeysHash = nullptr;
+				OldestUsed = Pair.Value.LastUsed;
+			}
+		}
+		for (const TPair<uint32, FSoundClassMixerCachedEnvelope>& Pair : KeyEnvelopes)
+		{
+			if (Pair.Value.LastUsed < OldestUsed)
+			{
+				OldestCurve = nullptr;
+				OldestKeysHash = &Pair.Key;
+				OldestUsed = Pair.Value.LastUsed;
+			}
+		}
+
+		// Keys are copied out, they live in the entry being removed.
+		if (OldestCurve)
+		{
+			const TWeakObjectPtr<UCurveFloat> Curve = *OldestCurve;
+			CurveEnvelopes.Remove(Curve);
+		}
+		else
+		{
+			const uint32 KeysHash = *OldestKeysHash;
+			KeyEnvelopes.Remove(KeysHash);
+		}
+	}
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::ApplyMixerSnapshotInternal(const USoundClassMixerSnapshot* Snapshot)
+{
+	check(IsInGameThread());
+
+	if (!Snapshot)
+	{
+		UE_LOG(LogSoundClassMixerSubsystem, Error, TEXT("Passed Mixer Snapshot is invalid."))
+		return;
+	}
+
+	FResolvedMixerSnapshot* Resolved = ResolvedSnapshots.Find(Snapshot);
+	if (!Resolved)
+	{
+		// Snapshots collected since the last miss leave stale keys behind.
+		for (TMap<TWeakObjectPtr<const USoundClassMixerSnapshot>, FResolvedMixerSnapshot>::TIterator It = ResolvedSnapshots.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		Resolved = &ResolvedSnapshots.Add(Snapshot);
+	}
+
+	// Entries were added or removed (editor); resolve them all again.
+	if (Resolved->SoundClassChannels.Num() != Snapshot->SoundClasses.Num())
+	{
+		Resolved->SoundClassChannels.Reset();
+		Resolved->SoundClassChannels.SetNum(Snapshot->SoundClasses.Num());
+	}
+	if (Resolved->SoundSubmixChannels.Num() != Snapshot->SoundSubmixes.Num())
+	{
+		Resolved->SoundSubmixChannels.Reset();
+		Resolved->SoundSubmixChannels.SetNum(Snapshot->SoundSubmixes.Num());
+	}
+
+	TArray<FSoundClassMixerCommand, TInlineAllocator<64>> Commands;
+	Commands.Reserve(Snapshot->SoundClasses.Num() + Snapshot->SoundSubmixes.Num());
+
+	for (int32 EntryIndex = 0; EntryIndex < Snapshot->SoundClasses.Num(); ++EntryIndex)
+	{
+		const FSoundClassMixerSnapshotSoundClass& Entry = Snapshot->SoundClasses[EntryIndex];
+
+		// Generation checked: a released or reused slot, or an entry retargeted in the editor, resolves again.
+		FMixerChannelHandle& Channel = Resolved->SoundClassChannels[EntryIndex];
+		const bool bIsResolved = IsChannelValid(Channel) && Channels[Channel.Index].Target == Entry.SoundClass;
+		if (!bIsResolved)
+		{
+			Channel = GetSoundClassChannel(Entry.SoundClass);
+		}
+
+		if (!Entry.SoundClass || !(IsChannelValid(Channel) || IsAssetPending(Entry.SoundClass)))
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Snapshot %s: skipping unmanaged Sound Class %s."),
+				*Snapshot->GetName(), *GetNameSafe(Entry.SoundClass))
+			continue;
+		}
+
+		FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+		Command.TargetType = ESoundClassMixerTargetType::SoundClass;
+		Command.Target     = Entry.SoundClass;
+		Command.Channel    = Channel;
+		Command.Volume     = FMath::Max(0.0f, Entry.Volume);
+		Command.Duration   = FMath::Max(0.0f, Entry.Duration);
+		Command.Type       = FMath::IsNearlyZero(Command.Duration) ? ESoundClassMixerCommandType::SetVolume : ESoundClassMixerCommandType::StartFade;
+		Command.Curve      = static_cast<Audio::EFaderCurve>(Entry.FadeCurve);
+		Command.bIsFadeOut = (Channel.IsSet() ? GetChannelVolumeInternal(Channel) : Entry.SoundClass->Properties.Volume) > Command.Volume;
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < Snapshot->SoundSubmixes.Num(); ++EntryIndex)
+	{
+		const FSoundClassMixerSnapshotSoundSubmix& Entry = Snapshot->SoundSubmixes[EntryIndex];
+
+		FMixerChannelHandle& Channel = Resolved->SoundSubmixChannels[EntryIndex];
+		const bool bIsResolved = IsChannelValid(Channel) && Channels[Channel.Index].Target == Entry.SoundSubmix;
+		if (!bIsResolved)
+		{
+			Channel = GetSoundSubmixChannel(Entry.SoundSubmix);
+		}
+
+		if (!Entry.SoundSubmix || !(IsChannelValid(Channel) || IsAssetPending(Entry.SoundSubmix)))
+		{
+			UE_LOG(LogSoundClassMixerSubsystem, Warning, TEXT("Snapshot %s: skipping unmanaged Sound Submix %s."),
+				*Snapshot->GetName(), *GetNameSafe(Entry.SoundSubmix))
+			continue;
+		}
+
+		const float Volume   = FMath::Max(0.0f, Entry.Volume);
+		const float Duration = FMath::Max(0.0f, Entry.Duration);
+
+		FSoundClassMixerCommand& Command = Commands.AddDefaulted_GetRef();
+		Command.TargetType = ESoundClassMixerTargetType::SoundSubmix;
+		Command.Target     = Entry.SoundSubmix;
+		Command.Channel    = Channel;
+		Command.Volume     = Volume;
+		Command.Duration   = Duration;
+		Command.Type       = FMath::IsNearlyZero(Duration) ? ESoundClassMixerCommandType::SetVolume : ESoundClassMixerCommandType::StartFade;
+		Command.Curve      = static_cast<Audio::EFaderCurve>(Entry.FadeCurve);
+		Command.bIsFadeOut = (Channel.IsSet() ? GetChannelVolumeInternal(Channel) : Entry.SoundSubmix->OutputVolume) > Volume;
+		Command.RenderFadeId = PushSubmixFaderSettings(Entry.SoundSubmix, Volume, Duration, Entry.FadeCurve, false);
+	}
+
+	EnqueueCommands(Commands);
+}
+
+// =====================================================================================================================
+
+USoundClassMixerSubmixFaderPreset* USoundClassMixerSubsystem::GetOrAddSubmixFader(USoundSubmix* SoundSubmixAsset)
+{
+	check(IsInGameThread());
+
+	if (USoundClassMixerSubmixFaderPreset** FoundPreset = SubmixFaderPresets.Find(SoundSubmixAsset))
+	{
+		return *FoundPreset;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Start the effect from the channel's fader gain, and leave the device stage the rest, so the
+	// first buffer neither ramps from unity nor applies the fader gain twice.
+	float FaderVolume = SoundSubmixAsset->OutputVolume;
+	float DeviceVolume = 1.0f;
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		if (const int32* ChannelIndex = SoundSubmixMap.Find(SoundSubmixAsset))
+		{
+			const FSoundSubSysProperties& Properties = Channels[*ChannelIndex].Properties;
+			FaderVolume = Properties.Fader.GetVolume();
+			DeviceVolume = Properties.DuckFader.GetVolume() * Properties.SidechainGain;
+		}
+	}
+
+	USoundClassMixerSubmixFaderPreset* Preset = NewObject<USoundClassMixerSubmixFaderPreset>(this);
+
+	FSoundClassMixerSubmixFaderSettings InitialSettings;
+	InitialSettings.InitialVolume = FaderVolume;
+	InitialSettings.TargetVolume = FaderVolume;
+	InitialSettings.FadeId = ++LastSubmixFadeId;
+	Preset->SetSettings(InitialSettings);
+	Preset->GetState()->Publish(FaderVolume, InitialSettings.FadeId, 0.0f);
+
+	UAudioMixerBlueprintLibrary::AddSubmixEffect(World, SoundSubmixAsset, Preset);
+
+	// Queued behind the effect so the fader gain moves from the device stage to the effect on the same buffer.
+	SyncAudioDevice();
+	SoundClassMixerSubsystemPrivate::SetSubmixOutputVolumesOnAudioThread(AudioDeviceId, { TPair<USoundSubmix*, float>(SoundSubmixAsset, DeviceVolume) });
+	InvalidateSubmixVolumeCache(SoundSubmixAsset);
+
+	SubmixFaderPresets.Add(SoundSubmixAsset, Preset);
+	return Preset;
+}
+
+int32 USoundClassMixerSubsystem::PushSubmixFaderSettings(
+	const USoundSubmix* SoundSubmixAsset,
+	const float Volume, const float Duration, const EAudioFaderCurve FadeCurve, const bool bStopFade
+)
+{
+	if (!GetDefault<USoundClassMixerSettings>()->bRenderThreadSubmixFades || !IsInGameThread())
+	{
+		return 0;
+	}
+
+	USoundSubmix* SoundSubmix = const_cast<USoundSubmix*>(SoundSubmixAsset);
+	USoundClassMixerSubmixFaderPreset* Preset = GetOrAddSubmixFader(SoundSubmix);
+	if (!Preset)
+	{
+		return 0;
+	}
+
+	// Attached on every push, the channel may have been registered again since the effect was added.
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		if (const int32* ChannelIndex = SoundSubmixMap.Find(SoundSubmix))
+		{
+			Channels[*ChannelIndex].Properties.RenderFaderState = Preset->GetState();
+		}
+	}
+
+	FSoundClassMixerSubmixFaderSettings Settings;
+	Settings.InitialVolume = Preset->Settings.InitialVolume;
+	Settings.TargetVolume  = Volume;
+	Settings.Duration      = Duration;
+	Settings.FadeCurve     = FadeCurve;
+	Settings.bStopFade     = bStopFade;
+	Settings.FadeId        = ++LastSubmixFadeId;
+	Preset->SetSettings(Settings);
+
+	return Settings.FadeId;
+}
+
+void USoundClassMixerSubsystem::RemoveSubmixFaders()
+{
+	check(IsInGameThread());
+
+	UWorld* World = GetWorld();
+	TArray<TPair<USoundSubmix*, float>> DeviceVolumes;
+	for (const TPair<USoundSubmix*, USoundClassMixerSubmixFaderPreset*>& Pair : SubmixFaderPresets)
+	{
+		if (World && Pair.Key && Pair.Value)
+		{
+			UAudioMixerBlueprintLibrary::RemoveSubmixEffectPreset(World, Pair.Key, Pair.Value);
+
+			// The device stage takes the fader gain back, from where the effect's fade has got to.
+			FScopeLock Lock(&AudioStateCriticalSection);
+			if (const int32* ChannelIndex = SoundSubmixMap.Find(Pair.Key))
+			{
+				FSoundSubSysProperties& Properties = Channels[*ChannelIndex].Properties;
+				if (Properties.bFaderOnRenderThread)
+				{
+					CatchUpRenderThreadFade(Properties);
+					Properties.bFaderOnRenderThread = false;
+				}
+				Properties.RenderFaderState.Reset();
+				Properties.LastAppliedDeviceVolume = -1.0f;
+				DeviceVolumes.Emplace(Pair.Key, Properties.Fader.GetVolume() * Properties.DuckFader.GetVolume() * Properties.SidechainGain);
+			}
+		}
+	}
+	SubmixFaderPresets.Reset();
+
+	SoundClassMixerSubsystemPrivate::SetSubmixOutputVolumesOnAudioThread(AudioDeviceId, MoveTemp(DeviceVolumes));
+}
+
+void USoundClassMixerSubsystem::CatchUpRenderThreadFade(FSoundSubSysProperties& Properties)
+{
+	if (!Properties.RenderFaderState)
+	{
+		return;
+	}
+
+	float ElapsedTime = 0.0f;
+	const int32 FadeId = Properties.RenderFaderState->GetFadeProgress(ElapsedTime);
+	if (FadeId == Properties.RenderFadeId)
+	{
+		Properties.Fader.Update(ElapsedTime);
+	}
+	else if (FadeId > Properties.RenderFadeId)
+	{
+		// The effect already moved on to a later request; it only left its gain behind.
+		Properties.Fader.SetVolume(Properties.RenderFaderState->Gain.load(std::memory_order_relaxed));
+	}
+	// Otherwise the effect hasn't rendered the fade yet, none of it has elapsed.
+}
+
+void USoundClassMixerSubsystem::InvalidateSubmixVolumeCache(const USoundSubmix* SoundSubmixAsset)
+{
+	FScopeLock Lock(&AudioStateCriticalSection);
+	if (const int32* ChannelIndex = SoundSubmixMap.Find(SoundSubmixAsset))
+	{
+		Channels[*ChannelIndex].Properties.LastAppliedDeviceVolume = -1.0f;
+	}
+}
+
+void USoundClassMixerSubsystem::SyncAudioDevice()
+{
+	check(IsInGameThread());
+
+	const UWorld* World = GetWorld();
+	FAudioDevice* AudioDevice = World ? World->GetAudioDeviceRaw() : nullptr;
+	const uint32 NewDeviceId = AudioDevice ? AudioDevice->DeviceID : static_cast<uint32>(INDEX_NONE);
+	const uint32 OldDeviceId = AudioDeviceId;
+	if (NewDeviceId == OldDeviceId)
+	{
+		return;
+	}
+
+	FAudioDevice* OldAudioDevice = GetMixerAudioDevice();
+
+	// Push/Pop hop to the audio thread ahead of the update dispatched after this.
+	if (DeviceSoundMix)
+	{
+		if (OldAudioDevice)
+		{
+			OldAudioDevice->PopSoundMixModifier(DeviceSoundMix);
+		}
+		if (AudioDevice)
+		{
+			AudioDevice->PushSoundMixModifier(DeviceSoundMix);
+		}
+	}
+
+	// Sidechains follow the device their targets are applied on, so RemoveSidechain finds them there.
+	for (const TPair<int32, FSoundClassMixerActiveSidechain>& Pair : Sidechains)
+	{
+		USoundSubmix* SourceSubmix = Pair.Value.SourceSubmix.Get();
+		if (OldAudioDevice)
+		{
+			OldAudioDevice->UnregisterSubmixBufferListener(Pair.Value.Listener.Get(), SourceSubmix);
+		}
+		if (AudioDevice && SourceSubmix)
+		{
+			AudioDevice->RegisterSubmixBufferListener(Pair.Value.Listener.Get(), SourceSubmix);
+		}
+	}
+
+	AudioDeviceId = NewDeviceId;
+
+	if (OldDeviceId == static_cast<uint32>(INDEX_NONE))
+	{
+		return;
+	}
+
+	// The new device has none of the applied volumes yet.
+	DECLARE_CYCLE_STAT(TEXT("USoundClassMixerSubsystem.DeviceChanged"), STAT_SoundClassMixerDeviceChanged, STATGROUP_AudioThreadCommands);
+	FAudioThread::RunCommandOnAudioThread(
+		[this]
+		{
+			FScopeLock Lock(&AudioStateCriticalSection);
+			for (int32 ChannelIndex = 0; ChannelIndex < Channels.Num(); ++ChannelIndex)
+			{
+				if (Channels[ChannelIndex].Target)
+				{
+					Channels[ChannelIndex].Properties.LastAppliedDeviceVolume = -1.0f;
+					MarkChannelActive(ChannelIndex);
+				}
+			}
+		},
+		GET_STATID(STAT_SoundClassMixerDeviceChanged)
+	);
+}
+
+FAudioDevice* USoundClassMixerSubsystem::GetMixerAudioDevice() const
+{
+	const uint32 DeviceId = AudioDeviceId;
+	FAudioDeviceManager* DeviceManager = FAudioDeviceManager::Get();
+	return DeviceManager && DeviceId != static_cast<uint32>(INDEX_NONE)
+		? DeviceManager->GetAudioDeviceRaw(DeviceId)
+		: nullptr;
+}
+
+// =====================================================================================================================
+
+bool USoundClassMixerSubsystem::IsReady() const
+{
+	return bInitialized && PendingAssetPaths.Num() == 0;
+}
+
+bool USoundClassMixerSubsystem::IsSoundClassReady(const USoundClass* SoundClassAsset) const
+{
+	return SoundClassMap.Contains(SoundClassAsset);
+}
+
+bool USoundClassMixerSubsystem::IsSoundSubmixReady(const USoundSubmix* SoundSubmixAsset) const
+{
+	return SoundSubmixMap.Contains(SoundSubmixAsset);
+}
+
+bool USoundClassMixerSubsystem::IsAssetPending(const UObject* Asset) const
+{
+	return Asset && PendingAssetPaths.Contains(FSoftObjectPath(Asset));
+}
+
+void USoundClassMixerSubsystem::EnqueueCommand(const FSoundClassMixerCommand& Command)
+{
+	EnqueueCommands(MakeArrayView(&Command, 1));
+}
+
+void USoundClassMixerSubsystem::EnqueueCommands(TArrayView<const FSoundClassMixerCommand> Commands)
+{
+	if (IsInAudioThread())
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		for (const FSoundClassMixerCommand& Command : Commands)
+		{
+			ApplyCommand(Command);
+		}
+		return;
+	}
+
+	check(IsInGameThread());
+
+	for (const FSoundClassMixerCommand& Command : Commands)
+	{
+		CoalesceCommand(Command);
+	}
+	bHasPendingWork = true;
+}
+
+void USoundClassMixerSubsystem::CoalesceCommand(const FSoundClassMixerCommand& Command)
+{
+	// The duck gain is its own fader, it doesn't supersede or get superseded by volume commands.
+	const bool bIsDuck = Command.Type == ESoundClassMixerCommandType::StartDuck;
+
+	// Zero length fades behave like SetVolume: they fully determine the fader on their own.
+	const bool bIsSet = Command.Type == ESoundClassMixerCommandType::SetVolume
+		|| ((Command.Type == ESoundClassMixerCommandType::StartFade || bIsDuck) && Command.Duration <= 0.0f);
+
+	FCoalescedCommandSlots& Slots = CoalescedCommandSlots.FindOrAdd(TPair<const UObject*, bool>(Command.Target, bIsDuck));
+
+	auto Supersede = [this](int32& CommandIndex)
+	{
+		if (CommandIndex != INDEX_NONE)
+		{
+			ReleaseCommandEnvelope(CoalescedCommands[CommandIndex]);
+			CoalescedCommands[CommandIndex].Target = nullptr;
+			CommandIndex = INDEX_NONE;
+			++NumCoalescedThisFrame;
+		}
+	};
+
+	Supersede(Slots.FadeIndex);
+	if (bIsSet)
+	{
+		Supersede(Slots.SetIndex);
+	}
+
+	// Latency counts from the call, so time spent waiting for the flush is included.
+	const int32 CommandIndex = CoalescedCommands.Add(Command);
+	CoalescedCommands[CommandIndex].EnqueueCycles = FPlatformTime::Cycles64();
+	(bIsSet ? Slots.SetIndex : Slots.FadeIndex) = CommandIndex;
+}
+
+void USoundClassMixerSubsystem::FlushCoalescedCommands()
+{
+	check(IsInGameThread());
+
+	if (CoalescedCommands.Num() == 0)
+	{
+		return;
+	}
+
+	if (NumCoalescedThisFrame > 0)
+	{
+		CommandQueueCoalescedCount += NumCoalescedThisFrame;
+		INC_DWORD_STAT_BY(STAT_SoundClassMixerCommandsCoalesced, NumCoalescedThisFrame);
+		CSV_CUSTOM_STAT(SoundClassMixer, CommandsCoalesced, NumCoalescedThisFrame, ECsvCustomStatOp::Accumulate);
+
+		CoalescedCommands.RemoveAll([](const FSoundClassMixerCommand& Command) { return Command.Target == nullptr; });
+		NumCoalescedThisFrame = 0;
+	}
+
+	const int32 NumSubmitted = SubmitCommands(CoalescedCommands);
+
+	// Both rings full: the rest waits for the next update, still ahead of anything issued later. Held commands
+	// aren't coalesced against newer ones, which is only a missed saving since they're applied first.
+	CoalescedCommands.RemoveAt(0, NumSubmitted, false);
+	CoalescedCommandSlots.Reset();
+}
+
+int32 USoundClassMixerSubsystem::SubmitCommands(TArrayView<const FSoundClassMixerCommand> Commands)
+{
+	check(IsInGameThread());
+
+	const uint64 EnqueueCycles = FPlatformTime::Cycles64();
+
+	int32 Index = 0;
+	for (; Index < Commands.Num(); ++Index)
+	{
+		const FSoundClassMixerCommand& Command = Commands[Index];
+
+		// Still streaming in; replayed by Register* once the asset is resident.
+		if (!Command.Channel.IsSet() && PendingAssetPaths.Num() > 0 && IsAssetPending(Command.Target))
+		{
+			// Restamped on replay, load time isn't command latency.
+			DeferredCommands.Add_GetRef(Command).EnqueueCycles = 0;
+			continue;
+		}
+
+		FSoundClassMixerCommand QueuedCommand = Command;
+		if (QueuedCommand.EnqueueCycles == 0)
+		{
+			QueuedCommand.EnqueueCycles = EnqueueCycles;
+		}
+
+		// Once spilling, keep spilling until the audio thread empties the overflow ring, so it never runs ahead.
+		if (OverflowQueue.IsEmpty() && CommandQueue.Enqueue(QueuedCommand))
+		{
+			continue;
+		}
+		if (OverflowQueue.Enqueue(QueuedCommand))
+		{
+			++CommandQueueOverflowCount;
+			INC_DWORD_STAT(STAT_SoundClassMixerCommandQueueOverflows);
+			continue;
+		}
+		break;
+	}
+
+	if (Index < Commands.Num())
+	{
+		CommandQueueHeldCount += Commands.Num() - Index;
+		UE_LOG(LogSoundClassMixerSubsystem, Verbose, TEXT("Command rings full, holding %d mixer commands for the next update."), Commands.Num() - Index);
+	}
+
+	if (Index > 0)
+	{
+		bHasPendingWork = true;
+	}
+
+	INC_DWORD_STAT_BY(STAT_SoundClassMixerCommandsEnqueued, Index);
+	CSV_CUSTOM_STAT(SoundClassMixer, CommandsEnqueued, Index, ECsvCustomStatOp::Accumulate);
+	return Index;
+}
+
+void USoundClassMixerSubsystem::DrainCommands()
 {
 	check(IsInAudioThread());
+	SCOPE_CYCLE_COUNTER(STAT_SoundClassMixerDrainCommands);
 
-	USoundSubmix* SoundSubmix = const_cast<USoundSubmix*>(SoundSubmixAsset);
-	SoundSubmix->OutputVolume = Volume;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The overflow ring only ever holds commands issued after everything in the main ring.
+	uint32 NumDrained = 0;
+	FSoundClassMixerCommand Command;
+	while (CommandQueue.Dequeue(Command))
+	{
+		ApplyCommand(Command);
+		++NumDrained;
+	}
+	while (OverflowQueue.Dequeue(Command))
+	{
+		ApplyCommand(Command);
+		++NumDrained;
+	}
+
+	CommandQueueLastDepth = NumDrained;
+	CommandQueuePeakDepth = FMath::Max(CommandQueuePeakDepth.load(), NumDrained);
+	CommandQueueLastDrainTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	SET_DWORD_STAT(STAT_SoundClassMixerCommandQueueDepth, NumDrained);
+	TRACE_COUNTER_SET(SoundClassMixerCommandsDrained, NumDrained);
+}
+
+void USoundClassMixerSubsystem::ReleaseCommandEnvelope(const FSoundClassMixerCommand& Command)
+{
+	check(IsInGameThread());
+
+	if (Command.EnvelopeId != 0)
+	{
+		FScopeLock Lock(&AudioStateCriticalSection);
+		CommandEnvelopes.Remove(Command.EnvelopeId);
+	}
+}
+
+void USoundClassMixerSubsystem::ApplyCommand(const FSoundClassMixerCommand& Command)
+{
+	check(IsInAudioThread());
+
+	// Taken before the validity check so stale commands release theirs too.
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> Envelope;
+	if (Command.EnvelopeId != 0)
+	{
+		CommandEnvelopes.RemoveAndCopyValue(Command.EnvelopeId, Envelope);
+	}
+
+	// Stale commands (slot released since the command was issued) are dropped.
+	if (!IsChannelValid(Command.Channel))
+	{
+		return;
+	}
+
+	if (Command.EnqueueCycles != 0)
+	{
+		const float LatencyMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Command.EnqueueCycles));
+		MaxCommandLatencyMs = FMath::Max(MaxCommandLatencyMs, LatencyMs);
+		CommandLatencyHistogram.Add(LatencyMs);
+	}
+
+	FSoundSubSysProperties* Props = &Channels[Command.Channel.Index].Properties;
+	MarkChannelActive(Command.Channel.Index);
+
+	if (Command.Type != ESoundClassMixerCommandType::StartDuck)
+	{
+		// The fader isn't advanced while the effect carries its fade; catch it up before the command replaces it.
+		if (Props->bFaderOnRenderThread)
+		{
+			CatchUpRenderThreadFade(*Props);
+		}
+		Props->bFaderOnRenderThread = Command.RenderFadeId != 0;
+		Props->RenderFadeId = Command.RenderFadeId;
+
+		// Replaced fades release their envelope, the new one is kept alive while the fader points to it.
+		Props->FaderEnvelope = MoveTemp(Envelope);
+	}
+
+	switch (Command.Type)
+	{
+		case ESoundClassMixerCommandType::SetVolume:
+		{
+			Props->bIsFading = false;
+			Props->Fader.SetVolume(Command.Volume);
+			break;
+		}
+
+		case ESoundClassMixerCommandType::StartFade:
+		{
+			Props->bIsFading = Command.bIsFadeOut || FMath::IsNearlyZero(Command.Volume);
+			Props->Fader.StartFade(Command.Volume, Command.Duration, Command.Curve);
+			break;
+		}
+
+		case ESoundClassMixerCommandType::StopFade:
+		{
+			Props->bIsFading = false;
+			Props->Fader.StopFade();
+			break;
+		}
+
+		case ESoundClassMixerCommandType::StartDuck:
+		{
+			Props->DuckFader.StartFade(Command.Volume, Command.Duration, Command.Curve);
+			break;
+		}
+
+		case ESoundClassMixerCommandType::StartEnvelope:
+		{
+			if (!Props->FaderEnvelope)
+			{
+				Props->Fader.StopFade();
+				break;
+			}
+			Props->bIsFading = FMath::IsNearlyZero(Props->FaderEnvelope->GetFinalVolume());
+			Props->Fader.StartEnvelope(Props->FaderEnvelope.Get());
+			break;
+		}
+	}
 
-	if (UWorld* World = GetWorld())
+	// Single segment fades run batched in the bank; anything else is dropped from it and updates per fader.
+	if (Command.Type != ESoundClassMixerCommandType::StartDuck)
 	{
-		if (FAudioDevice* AudioDevice = World->GetAudioDeviceRaw())
+		if (Props->bFaderOnRenderThread)
+		{
+			FaderBank.Remove(Command.Channel.Index);
+		}
+		else
 		{
-			AudioDevice->SetSubmixOutputVolume(SoundSubmix, Volume);
+			FaderBank.Add(Command.Channel.Index, Props->Fader);
 		}
 	}
 }
 
+FSoundClassMixerCommandQueueStats USoundClassMixerSubsystem::GetCommandQueueStats() const
+{
+	FSoundClassMixerCommandQueueStats Stats;
+	Stats.LastQueueDepth  = CommandQueueLastDepth;
+	Stats.PeakQueueDepth  = CommandQueuePeakDepth;
+	Stats.OverflowCount   = CommandQueueOverflowCount;
+	Stats.HeldCount       = CommandQueueHeldCount;
+	Stats.LastDrainTimeMs = CommandQueueLastDrainTimeMs;
+	Stats.CoalescedCount  = CommandQueueCoalescedCount;
+	return Stats;
+}
+
+FSoundClassMixerLatencyStats USoundClassMixerSubsystem::GetCommandLatencyStats() const
+{
+	FSoundClassMixerLatencyStats Stats;
+	Stats.P50Ms      = CommandLatencyHistogram.GetPercentile(0.50f);
+	Stats.P95Ms      = CommandLatencyHistogram.GetPercentile(0.95f);
+	Stats.P99Ms      = CommandLatencyHistogram.GetPercentile(0.99f);
+	Stats.MaxMs      = CommandLatencyHistogram.GetMax();
+	Stats.NumSamples = static_cast<int32>(CommandLatencyHistogram.GetNumSamples());
+	return Stats;
+}
+
+void USoundClassMixerSubsystem::ResetCommandLatencyStats()
+{
+	CommandLatencyHistogram.Reset();
+}
+
+namespace SoundClassMixerSubsystemPrivate
+{
+	USoundClassMixerSubsystem* GetWorldSubsystem(const UWorld* World)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<USoundClassMixerSubsystem>() : nullptr;
+	}
+
+	// Registered by the runtime module, the latency is worth measuring in packaged builds too.
+	FAutoConsoleCommandWithWorld LatencyReportCommand(
+		TEXT("SoundClassMixer.Latency.Report"),
+		TEXT("Prints game thread -> audio thread command latency percentiles."),
+		FConsoleCommandWithWorldDelegate::CreateLambda(
+			[](UWorld* World)
+			{
+				if (const USoundClassMixerSubsystem* Subsystem = GetWorldSubsystem(World))
+				{
+					const FSoundClassMixerLatencyStats Stats = Subsystem->GetCommandLatencyStats();
+					UE_LOG(LogSoundClassMixerSubsystem, Display, TEXT("Command latency over %d commands: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms"),
+						Stats.NumSamples, Stats.P50Ms, Stats.P95Ms, Stats.P99Ms, Stats.MaxMs);
+				}
+			}
+		)
+	);
+
+	FAutoConsoleCommandWithWorld LatencyResetCommand(
+		TEXT("SoundClassMixer.Latency.Reset"),
+		TEXT("Clears the command latency histogram."),
+		FConsoleCommandWithWorldDelegate::CreateLambda(
+			[](UWorld* World)
+			{
+				if (USoundClassMixerSubsystem* Subsystem = GetWorldSubsystem(World))
+				{
+					Subsystem->ResetCommandLatencyStats();
+				}
+			}
+		)
+	);
+}
+
+// =====================================================================================================================
+
+void USoundClassMixerSubsystem::ApplySubmixVolume(const USoundSubmix* SoundSubmixAsset, const float DeviceVolume)
+{
+	check(IsInAudioThread());
+	SCOPE_CYCLE_COUNTER(STAT_SoundClassMixerSubmixApply);
+	CSV_SCOPED_TIMING_STAT(SoundClassMixer, SubmixApply);
+
+	if (FAudioDevice* AudioDevice = GetMixerAudioDevice())
+	{
+		AudioDevice->SetSubmixOutputVolume(const_cast<USoundSubmix*>(SoundSubmixAsset), DeviceVolume);
+	}
+}
+
+void USoundClassMixerSubsystem::ApplySoundClassVolume(const USoundClass* SoundClassAsset, const float Volume)
+{
+	check(IsInAudioThread());
+	check(DeviceSoundMix);
+
+	FAudioDevice* AudioDevice = GetMixerAudioDevice();
+	if (!AudioDevice)
+	{
+		return;
+	}
+
+	// The override scales the authored volume; divide it out so both modes end at the same volume. Set on this
+	// class only, the device multiplies the adjusted parent volumes down the tree like it does the asset volumes,
+	// and every managed class carries its own override.
+	// A class authored at (about) zero stays silent whatever the override, there is nothing to scale; the adjuster
+	// is left at unity for it instead of dividing by ~0, see RegisterSoundClass.
+	USoundClass* SoundClass = const_cast<USoundClass*>(SoundClassAsset);
+	const float AuthoredVolume = SoundClass->Properties.Volume;
+	const float VolumeAdjuster = AuthoredVolume > KINDA_SMALL_NUMBER ? Volume / AuthoredVolume : 1.0f;
+	AudioDevice->SetSoundMixClassOverride(DeviceSoundMix, SoundClass, VolumeAdjuster, 1.0f, 0.0f, false);
+}
+
 void USoundClassMixerSubsystem::UpdateAudioClasses()
 {
+	if (IsInGameThread())
+	{
+		SyncAudioDevice();
+		FlushCoalescedCommands();
+	}
+
 	if (!IsInAudioThread())
 	{
 		check(IsInGameThread());
@@ -385,27 +2308,251 @@ void USoundClassMixerSubsystem::UpdateAudioClasses()
 		return;
 	}
 
-	const float DeltaTime = FMath::Min(static_cast<float>(FApp::GetDeltaTime()), 0.5f);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("SoundClassMixer::UpdateAudioClasses", SoundClassMixerChannel);
+
+	FScopeLock Lock(&AudioStateCriticalSection);
+
+	DrainCommands();
+
+	const float DeltaTime = FSimpleFader::ConsumeFixedTimeSteps(
+		FMath::Min(static_cast<float>(FApp::GetDeltaTime()), 0.5f),
+		GetDefault<USoundClassMixerSettings>()->FaderFixedTimeStep,
+		FaderTimeAccumulator
+	);
+
+	const float SubmixVolumeEpsilon = GetDefault<USoundClassMixerSettings>()->SubmixVolumeEpsilon;
+	uint32 NumDeviceCallsSkipped = 0;
+
+	// The listeners only publish their gain, it is picked up here once per update.
+	ApplySidechainGains(SubmixVolumeEpsilon, NumDeviceCallsSkipped);
+
+	FaderBank.Update(DeltaTime);
+
+	// Only channels that are fading or were just set are visited; idle faders have nothing to apply.
+	SCOPE_CYCLE_COUNTER(STAT_SoundClassMixerFaderUpdate);
+	CSV_SCOPED_TIMING_STAT(SoundClassMixer, FaderUpdate);
+	for (int32 ActiveIndex = ActiveChannels.Num() - 1; ActiveIndex >= 0; --ActiveIndex)
+	{
+		const int32 ChannelIndex = ActiveChannels[ActiveIndex];
+		FSoundClassMixerChannel& Channel = Channels[ChannelIndex];
+		if (!Channel.Target)
+		{
+			FaderBank.Remove(ChannelIndex);
+			Channel.bIsActive = false;
+			ActiveChannels.RemoveAtSwap(ActiveIndex, 1, false);
+			continue;
+		}
+
+		FSimpleFader& Fader = Channel.Properties.Fader;
+		FSimpleFader& DuckFader = Channel.Properties.DuckFader;
+
+		// The render thread fader effect ramps that gain per buffer; the fader is caught up by the next command
+		// (volume queries read the effect's gain) instead of being mirrored here, and holds the fade's end volume meanwhile.
+		const bool bFaderOnRenderThread = Channel.Properties.bFaderOnRenderThread;
+
+		float FaderVolume;
+		if (bFaderOnRenderThread)
+		{
+			FaderVolume = Fader.GetVolumeAfterTime(Fader.GetFadeDuration());
+		}
+		else if (FaderBank.Contains(ChannelIndex))
+		{
+			FaderVolume = FaderBank.Sync(ChannelIndex, Fader);
+		}
+		else
+		{
+			Fader.Update(DeltaTime);
+			FaderVolume = Fader.GetVolume();
+		}
+		DuckFader.Update(DeltaTime);
+
+		const bool bIsSettled = (bFaderOnRenderThread || !Fader.IsFading()) && !DuckFader.IsFading();
+		ApplyChannelVolume(Channel, FaderVolume, bIsSettled, SubmixVolumeEpsilon, NumDeviceCallsSkipped);
+
+		if (bIsSettled)
+		{
+			// A finished envelope is no longer referenced by the fader.
+			if (!Fader.IsFading())
+			{
+				Channel.Properties.FaderEnvelope.Reset();
+			}
+
+			Channel.bIsActive = false;
+			ActiveChannels.RemoveAtSwap(ActiveIndex, 1, false);
+		}
+	}
+
+	PropagateDirtySoundClassNodes();
+
+	INC_DWORD_STAT_BY(STAT_SoundClassMixerDeviceCallsSkipped, NumDeviceCallsSkipped);
+	CSV_CUSTOM_STAT(SoundClassMixer, DeviceCallsSkipped, static_cast<int32>(NumDeviceCallsSkipped), ECsvCustomStatOp::Set);
+
+	SET_DWORD_STAT(STAT_SoundClassMixerActiveFades, ActiveChannels.Num());
+	SET_FLOAT_STAT(STAT_SoundClassMixerCommandLatency, MaxCommandLatencyMs);
+	CSV_CUSTOM_STAT(SoundClassMixer, ActiveFades, ActiveChannels.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SoundClassMixer, CommandLatencyMs, MaxCommandLatencyMs, ECsvCustomStatOp::Set);
+	TRACE_COUNTER_SET(SoundClassMixerActiveFades, ActiveChannels.Num());
+	TRACE_COUNTER_SET(SoundClassMixerCommandLatency, MaxCommandLatencyMs);
+	MaxCommandLatencyMs = 0.0f;
+
+	// The next fade starts on a fresh step grid rather than inheriting this one's remainder.
+	if (ActiveChannels.Num() == 0)
+	{
+		FaderTimeAccumulator = 0.0f;
+	}
+
+	// Clear first, then re-check: a command enqueued in between either shows up here or raises the flag again.
+	bHasPendingWork = false;
+	if (!CommandQueue.IsEmpty() || ActiveChannels.Num() > 0 || Sidechains.Num() > 0)
+	{
+		bHasPendingWork = true;
+	}
+}
+
+void USoundClassMixerSubsystem::ApplyChannelVolume(FSoundClassMixerChannel& Channel, const float FaderVolume, const bool bIsSettled, const float SubmixVolumeEpsilon, uint32& NumDeviceCallsSkipped)
+{
+	const FSimpleFader& DuckFader = Channel.Properties.DuckFader;
+	const bool bFaderOnRenderThread = Channel.Properties.bFaderOnRenderThread;
+
+	const float Volume = FaderVolume * DuckFader.GetVolume() * Channel.Properties.SidechainGain;
+
+	Channel.Properties.Volume = Volume;
+
+	const bool bIsSoundClass = Channel.TargetType == ESoundClassMixerTargetType::SoundClass;
+	if (bIsSoundClass && Channel.HierarchyIndex != INDEX_NONE)
+	{
+		DirtySoundClassNodes.Add(Channel.HierarchyIndex);
+	}
+
+	if (bIsSoundClass && !DeviceSoundMix)
+	{
+		// The device reads the asset's volume itself, there is no call to save.
+		static_cast<USoundClass*>(Channel.Target)->Properties.Volume = Volume;
+	}
+	else
+	{
+		float DeviceVolume = Volume;
+		if (!bIsSoundClass)
+		{
+			if (!DeviceSoundMix)
+			{
+				static_cast<USoundSubmix*>(Channel.Target)->OutputVolume = Volume;
+			}
+
+			// The render thread fader effect carries the fader's gain, the device stage gets the rest.
+			if (bFaderOnRenderThread)
+			{
+				DeviceVolume = DuckFader.GetVolume() * Channel.Properties.SidechainGain;
+			}
+		}
+
+		// Every device call queues a mixer side command; only send gains that moved.
+		float& LastAppliedVolume = Channel.Properties.LastAppliedDeviceVolume;
+		const bool bHasChanged = LastAppliedVolume < 0.0f
+			|| (bIsSettled ? DeviceVolume != LastAppliedVolume : FMath::Abs(DeviceVolume - LastAppliedVolume) > SubmixVolumeEpsilon);
+
+		if (!bHasChanged)
+		{
+			++NumDeviceCallsSkipped;
+		}
+		else
+		{
+			if (bIsSoundClass)
+			{
+				ApplySoundClassVolume(static_cast<USoundClass*>(Channel.Target), DeviceVolume);
+			}
+			else
+			{
+				ApplySubmixVolume(static_cast<USoundSubmix*>(Channel.Target), DeviceVolume);
+			}
+			LastAppliedVolume = DeviceVolume;
+		}
+	}
+}
+
+void USoundClassMixerSubsystem::PropagateDirtySoundClassNodes()
+{
+	// Pre-order: a dirty node's subtree follows it, so one sorted sweep covers nested changes once.
+	if (DirtySoundClassNodes.Num() == 0)
+	{
+		return;
+	}
+
+	DirtySoundClassNodes.Sort();
 
-	for (TPair<USoundClass*, FSoundSubSysProperties>& Pair : SoundClassMap)
+	int32 CoveredEnd = 0;
+	for (const int32 NodeIndex : DirtySoundClassNodes)
 	{
-		USoundClass* SoundClass = Pair.Key;
-		FSoundSubSysProperties& SoundClassProps = Pair.Value;
+		if (NodeIndex < CoveredEnd)
+		{
+			continue;
+		}
+		CoveredEnd = SoundClassHierarchy[NodeIndex].SubtreeEnd;
+		PropagateSoundClassVolumes(NodeIndex, CoveredEnd);
+	}
+	DirtySoundClassNodes.Reset();
+}
+
+void USoundClassMixerSubsystem::MarkChannelActive(const int32 ChannelIndex)
+{
+	check(IsInAudioThread());
 
-		SoundClassProps.Fader.Update(DeltaTime);
-		SoundClass->Properties.Volume = SoundClassProps.Fader.GetVolume();
+	FSoundClassMixerChannel& Channel = Channels[ChannelIndex];
+	if (!Channel.bIsActive)
+	{
+		Channel.bIsActive = true;
+		ActiveChannels.Add(ChannelIndex);
 	}
+	bHasPendingWork = true;
+}
 
-	for (TPair<USoundSubmix*, FSoundSubSysProperties>& Pair : SoundSubmixMap)
+// =====================================================================================================================
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+void USoundClassMixerSubsystem::ResetChannelsForTesting()
+{
 	{
-		USoundSubmix* SoundSubmix = Pair.Key;
-		FSoundSubSysProperties& SoundSubmixProps = Pair.Value;
+		FScopeLock Lock(&AudioStateCriticalSection);
+		ReleaseAllChannels();
+	}
+	SoundClassNameIndex.Reset();
+	SoundSubmixNameIndex.Reset();
+}
+
+void USoundClassMixerSubsystem::GatherFromAssetRegistryForTesting()
+{
+	check(!GetDefault<USoundClassMixerSettings>()->bAsyncGather);
+
+	GatherFromAssetRegistry();
+	RebuildSoundClassHierarchy();
+}
+
+void USoundClassMixerSubsystem::GatherFromManifestForTesting(const FSoundClassMixerManifest& Manifest)
+{
+	check(!GetDefault<USoundClassMixerSettings>()->bAsyncGather);
 
-		SoundSubmixProps.Fader.Update(DeltaTime);
-		ApplySubmixVolume(SoundSubmix, SoundSubmixProps.Fader.GetVolume());
+	GatherFromManifest(Manifest);
+	RebuildSoundClassHierarchy();
+}
+
+void USoundClassMixerSubsystem::RegisterSoundClassesForTesting(const TArrayView<USoundClass* const> SoundClasses)
+{
+	for (USoundClass* SoundClass : SoundClasses)
+	{
+		RegisterSoundClass(SoundClass);
 	}
+	RebuildSoundClassHierarchy();
 }
 
+void USoundClassMixerSubsystem::DrainCommandsForTesting()
+{
+	FScopeLock Lock(&AudioStateCriticalSection);
+	DrainCommands();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
 // =====================================================================================================================
 
 TStatId USoundClassMixerSubsystem::GetStatId() const
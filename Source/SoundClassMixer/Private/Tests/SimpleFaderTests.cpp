@@ -0,0 +1,341 @@
+﻿#include "SimpleFader.h"
+#include "SimpleFaderBank.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SimpleFaderTestsPrivate
+{
+	constexpr float FadeDuration = 2.0f;
+	constexpr float FadeFrom = 0.1f;
+	constexpr float FadeTo = 0.9f;
+	constexpr int32 NumSequences = 32;
+
+	/** Frame deltas between 1/240 and 1/15 s, covering high refresh rates through hitches. */
+	float RandomDelta(FRandomStream& Stream)
+	{
+		return Stream.FRandRange(1.0f / 240.0f, 1.0f / 15.0f);
+	}
+
+	/**
+	 * The FadeFrom -> FadeTo fade's volume InTime seconds in, written out from the curve definitions rather
+	 * than through FSimpleFader: the fade runs linearly in volume (decibels for Logarithmic), then the curve shapes it.
+	 */
+	float ExpectedVolume(const Audio::EFaderCurve Curve, const float InTime)
+	{
+		const float Alpha = FMath::Clamp(InTime / FadeDuration, 0.0f, 1.0f);
+
+		switch (Curve)
+		{
+		case Audio::EFaderCurve::SCurve:
+		{
+			return 0.5f - 0.5f * FMath::Cos(PI * FMath::Lerp(FadeFrom, FadeTo, Alpha));
+		}
+
+		case Audio::EFaderCurve::Sin:
+		{
+			return FMath::Sin(HALF_PI * FMath::Lerp(FadeFrom, FadeTo, Alpha));
+		}
+
+		case Audio::EFaderCurve::Logarithmic:
+		{
+			const float FromDb = 20.0f * FMath::LogX(10.0f, FadeFrom);
+			const float ToDb = 20.0f * FMath::LogX(10.0f, FadeTo);
+			return FMath::Pow(10.0f, FMath::Lerp(FromDb, ToDb, Alpha) / 20.0f);
+		}
+
+		default:
+		{
+			return FMath::Lerp(FadeFrom, FadeTo, Alpha);
+		}
+		}
+	}
+
+	/** The pre closed-form update: steps the remaining distance by Delta / RemainingTime each frame. */
+	struct FIncrementalStepper
+	{
+		float Current = 0.0f;
+		float Target = 0.0f;
+		float Duration = 0.0f;
+		float Elapsed = 0.0f;
+
+		void Update(const float InDeltaTime)
+		{
+			if (Elapsed >= Duration)
+			{
+				return;
+			}
+
+			const float MinValue = FMath::Min(Current, Target);
+			const float MaxValue = FMath::Max(Current, Target);
+			Current = FMath::Clamp(Current + (Target - Current) * InDeltaTime / (Duration - Elapsed), MinValue, MaxValue);
+
+			Elapsed += InDeltaTime;
+			if (Elapsed >= Duration)
+			{
+				Current = Target;
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSimpleFaderFrameRateIndependenceTest,
+	"SoundClassMixer.SimpleFader.FrameRateIndependence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FSimpleFaderFrameRateIndependenceTest::RunTest(const FString& Parameters)
+{
+	using namespace SimpleFaderTestsPrivate;
+
+	const Audio::EFaderCurve Curves[] = {
+		Audio::EFaderCurve::Linear, Audio::EFaderCurve::SCurve, Audio::EFaderCurve::Sin, Audio::EFaderCurve::Logarithmic
+	};
+
+	FRandomStream Stream(0x5C3F);
+
+	for (const Audio::EFaderCurve Curve : Curves)
+	{
+		float MaxDeviation = 0.0f;
+		float MaxStepperDeviation = 0.0f;
+
+		for (int32 Sequence = 0; Sequence < NumSequences; ++Sequence)
+		{
+			FSimpleFader Fader;
+			Fader.SetVolume(FadeFrom);
+			Fader.StartFade(FadeTo, FadeDuration, Curve);
+
+			FIncrementalStepper Stepper;
+			Stepper.Current = FadeFrom;
+			Stepper.Target = FadeTo;
+			Stepper.Duration = FadeDuration;
+
+			// Summed in float like the fader's own ElapsedTime, so both agree on when the duration is reached.
+			float Time = 0.0f;
+			while (Fader.IsFading())
+			{
+				const float Delta = RandomDelta(Stream);
+				Fader.Update(Delta);
+				Stepper.Update(Delta);
+				Time += Delta;
+
+				// The fade must be over on the first update that reaches its duration, and not before.
+				if (Time >= FadeDuration)
+				{
+					TestFalse(TEXT("Fade completes on the update that reaches its duration"), Fader.IsFading());
+				}
+				else if (!Fader.IsFading())
+				{
+					AddError(FString::Printf(TEXT("Fade completed early at %.6f s (duration %.6f s)"), Time, FadeDuration));
+					break;
+				}
+
+				MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(Fader.GetVolume() - ExpectedVolume(Curve, Time)));
+				if (Curve == Audio::EFaderCurve::Linear)
+				{
+					MaxStepperDeviation = FMath::Max(MaxStepperDeviation, FMath::Abs(Fader.GetVolume() - Stepper.Current));
+				}
+			}
+
+			TestEqual(TEXT("Completed fade lands exactly on the target"), Fader.GetVolume(), FadeTo, 1.e-5f);
+		}
+
+		// Bounded by the lookup tables' documented error, ~1e-5 absolute and ~1e-4 relative for Logarithmic.
+		TestTrue(FString::Printf(TEXT("Curve %d: max deviation %g from the curve"), static_cast<int32>(Curve), MaxDeviation), MaxDeviation <= 2.e-4f);
+
+		if (Curve == Audio::EFaderCurve::Linear)
+		{
+			TestTrue(FString::Printf(TEXT("Max deviation %g from the incremental stepper"), MaxStepperDeviation), MaxStepperDeviation <= 1.e-3f);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSimpleFaderFixedTimeStepTest,
+	"SoundClassMixer.SimpleFader.FixedTimeStep",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FSimpleFaderFixedTimeStepTest::RunTest(const FString& Parameters)
+{
+	using namespace SimpleFaderTestsPrivate;
+
+	// A power of two step sums exactly in float, so every frame rate lands on the same step count.
+	constexpr float FixedTimeStep = 1.0f / 64.0f;
+
+	// Checkpoints every 1/6 s fall on a frame boundary at each rate.
+	constexpr int32 NumCheckpointsPerSecond = 6;
+	const int32 FrameRates[] = { 30, 60, 144 };
+
+	const Audio::EFaderCurve Curves[] = {
+		Audio::EFaderCurve::Linear, Audio::EFaderCurve::SCurve, Audio::EFaderCurve::Sin, Audio::EFaderCurve::Logarithmic
+	};
+
+	for (const Audio::EFaderCurve Curve : Curves)
+	{
+		TArray<float> FirstRateVolumes;
+
+		for (const int32 FrameRate : FrameRates)
+		{
+			// Same path as UpdateAudioClasses: the frame delta goes through the accumulator before the fader.
+			FSimpleFader Fader;
+			Fader.SetVolume(FadeFrom);
+			Fader.StartFade(FadeTo, FadeDuration, Curve);
+			float Accumulator = 0.0f;
+
+			const int32 FramesPerCheckpoint = FrameRate / NumCheckpointsPerSecond;
+			const int32 NumFrames = FMath::RoundToInt(FadeDuration * FrameRate);
+
+			TArray<float> Volumes;
+			for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+			{
+				Fader.Update(FSimpleFader::ConsumeFixedTimeSteps(1.0f / FrameRate, FixedTimeStep, Accumulator));
+
+				if (Frame % FramesPerCheckpoint == 0)
+				{
+					Volumes.Add(Fader.GetVolume());
+				}
+			}
+
+			for (int32 Checkpoint = 0; Checkpoint < Volumes.Num(); ++Checkpoint)
+			{
+				// Checkpoints on a step boundary depend on how the float deltas round, skip those.
+				const int32 CheckpointSixths = Checkpoint + 1;
+				if ((CheckpointSixths * 64) % NumCheckpointsPerSecond == 0)
+				{
+					continue;
+				}
+
+				const float Time = static_cast<float>(CheckpointSixths) / NumCheckpointsPerSecond;
+				const float GridTime = FMath::FloorToFloat(Time / FixedTimeStep) * FixedTimeStep;
+				TestTrue(
+					FString::Printf(TEXT("Curve %d at %d Hz: volume at %.3f s sits on the step grid"), static_cast<int32>(Curve), FrameRate, Time),
+					FMath::IsNearlyEqual(Volumes[Checkpoint], ExpectedVolume(Curve, GridTime), 2.e-4f)
+				);
+
+				if (FirstRateVolumes.IsValidIndex(Checkpoint))
+				{
+					TestTrue(
+						FString::Printf(TEXT("Curve %d: %d Hz matches %d Hz at %.3f s"), static_cast<int32>(Curve), FrameRate, FrameRates[0], Time),
+						FMath::IsNearlyEqual(Volumes[Checkpoint], FirstRateVolumes[Checkpoint], 1.e-6f)
+					);
+				}
+			}
+
+			if (FirstRateVolumes.Num() == 0)
+			{
+				FirstRateVolumes = MoveTemp(Volumes);
+			}
+		}
+	}
+
+	// Random frame deltas: the last update may carry several steps, the one reaching the duration must be among them.
+	{
+		FRandomStream Stream(0x7A51);
+
+		FSimpleFader Fader;
+		Fader.SetVolume(FadeFrom);
+		Fader.StartFade(FadeTo, FadeDuration, Audio::EFaderCurve::Linear);
+		float Accumulator = 0.0f;
+
+		int32 NumStepsTaken = 0;
+		int32 NumStepsBeforeLastUpdate = 0;
+		while (Fader.IsFading())
+		{
+			NumStepsBeforeLastUpdate = NumStepsTaken;
+
+			const float SteppedTime = FSimpleFader::ConsumeFixedTimeSteps(RandomDelta(Stream), FixedTimeStep, Accumulator);
+			Fader.Update(SteppedTime);
+			NumStepsTaken += FMath::RoundToInt(SteppedTime / FixedTimeStep);
+
+			TestTrue(TEXT("Fixed step volume sits on the step grid"),
+				FMath::IsNearlyEqual(Fader.GetVolume(), ExpectedVolume(Audio::EFaderCurve::Linear, NumStepsTaken * FixedTimeStep), 1.e-4f));
+		}
+
+		const int32 CompletionStep = FMath::CeilToInt(FadeDuration / FixedTimeStep);
+		TestTrue(TEXT("Fixed step fade completes on the update reaching the duration"),
+			NumStepsBeforeLastUpdate < CompletionStep && CompletionStep <= NumStepsTaken);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSimpleFaderBankMatchesScalarTest,
+	"SoundClassMixer.SimpleFader.BankMatchesScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter
+)
+
+bool FSimpleFaderBankMatchesScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace SimpleFaderTestsPrivate;
+
+	// Not a multiple of the vector width, so every lane has a padded tail.
+	constexpr int32 NumFaders = 103;
+
+	const Audio::EFaderCurve Curves[] = {
+		Audio::EFaderCurve::Linear, Audio::EFaderCurve::SCurve, Audio::EFaderCurve::Sin, Audio::EFaderCurve::Logarithmic
+	};
+
+	FRandomStream Stream(0xB4C7);
+
+	TArray<FSimpleFader> Scalar;
+	TArray<FSimpleFader> Banked;
+	FSimpleFaderBank Bank;
+
+	for (int32 FaderId = 0; FaderId < NumFaders; ++FaderId)
+	{
+		FSimpleFader Fader;
+		Fader.SetVolume(Stream.FRand());
+		Fader.StartFade(Stream.FRand(), Stream.FRandRange(0.25f, FadeDuration), Curves[FaderId % UE_ARRAY_COUNT(Curves)]);
+
+		Scalar.Add(Fader);
+		Banked.Add(Fader);
+		Bank.Add(FaderId, Banked.Last());
+	}
+	TestEqual(TEXT("Every fade is tracked"), Bank.Num(), NumFaders);
+
+	float MaxDeviation = 0.0f;
+	for (int32 Frame = 0; Bank.Num() > 0; ++Frame)
+	{
+		const float Delta = RandomDelta(Stream);
+
+		// Restarting some fades mid-flight exercises the lane swap-removal.
+		if (Frame == 10)
+		{
+			for (int32 FaderId = 0; FaderId < NumFaders; FaderId += 7)
+			{
+				Scalar[FaderId].StartFade(0.5f, 1.0f, Audio::EFaderCurve::Sin);
+				Banked[FaderId].StartFade(0.5f, 1.0f, Audio::EFaderCurve::Sin);
+				Bank.Add(FaderId, Banked[FaderId]);
+			}
+		}
+
+		Bank.Update(Delta);
+		for (int32 FaderId = 0; FaderId < NumFaders; ++FaderId)
+		{
+			Scalar[FaderId].Update(Delta);
+
+			float BankedVolume = Banked[FaderId].GetVolume();
+			if (Bank.Contains(FaderId))
+			{
+				BankedVolume = Bank.Sync(FaderId, Banked[FaderId]);
+			}
+
+			MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(BankedVolume - Scalar[FaderId].GetVolume()));
+			TestEqual(TEXT("Bank and scalar agree on whether the fade is running"), Banked[FaderId].IsFading(), Scalar[FaderId].IsFading());
+		}
+	}
+
+	// Both sides evaluate the same closed form and tables; only vector vs scalar rounding differs.
+	TestTrue(FString::Printf(TEXT("Max deviation %g between bank and scalar faders"), MaxDeviation), MaxDeviation <= 1.e-5f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
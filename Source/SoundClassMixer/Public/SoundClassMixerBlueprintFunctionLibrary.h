@@ -4,12 +4,14 @@
 
 #include "Sound/SoundSourceBusSend.h"
 #include "SoundClassMixerSourceBusSendInfo.h"
+#include "SoundClassMixerSubsystem.h"
 
 #include "SoundClassMixerBlueprintFunctionLibrary.generated.h"
 
 class USoundConcurrency;
 class USoundClass;
 class USoundSubmix;
+class USoundClassMixerSnapshot;
 class UAudioComponent;
 enum class EAudioFaderCurve : uint8;
 
@@ -45,8 +47,12 @@ class SOUNDCLASSMIXER_API USoundClassMixerBlueprintFunctionLibrary : public UBlu
 		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 			static void SetSoundClassVolume(const UObject* WorldContextObject, USoundClass* TargetClass, const float NewVolume);
 		
-		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin)
-			static float GetSoundClassVolume(USoundClass* TargetClass);
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void StopSoundClassFade(const UObject* WorldContextObject, USoundClass* TargetClass);
+		
+		/** The mixed volume, which in device-scoped mode differs from the asset's own. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static float GetSoundClassVolume(const UObject* WorldContextObject, USoundClass* TargetClass);
 
 		
 	public:
@@ -60,8 +66,74 @@ class SOUNDCLASSMIXER_API USoundClassMixerBlueprintFunctionLibrary : public UBlu
 		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
 			static void SetSoundSubmixVolume(const UObject* WorldContextObject, USoundSubmix* TargetClass, float NewVolume);
 		
-		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin)
-			static float GetSoundSubmixVolume(USoundSubmix* TargetClass);
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void StopSoundSubmixFade(const UObject* WorldContextObject, USoundSubmix* TargetClass);
+		
+		/** The mixed volume, which in device-scoped mode differs from the asset's own. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static float GetSoundSubmixVolume(const UObject* WorldContextObject, USoundSubmix* TargetClass);
+
+
+	public:
+		/** Resolve once and reuse the handle for every later call; it stops validating if the channel is released. */
+		UFUNCTION(BlueprintPure, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static FMixerChannelHandle GetSoundClassChannel(const UObject* WorldContextObject, USoundClass* TargetClass);
+
+		UFUNCTION(BlueprintPure, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static FMixerChannelHandle GetSoundSubmixChannel(const UObject* WorldContextObject, USoundSubmix* TargetSubmix);
+
+		UFUNCTION(BlueprintPure, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static bool IsMixerChannelValid(const UObject* WorldContextObject, FMixerChannelHandle Channel);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void MixerChannelFadeTo(
+				const UObject* WorldContextObject,
+				FMixerChannelHandle Channel, float FadeDuration, float FadeVolumeLevel,
+				EAudioFaderCurve FadeCurve
+			);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void SetMixerChannelVolume(const UObject* WorldContextObject, FMixerChannelHandle Channel, float NewVolume);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void StopMixerChannelFade(const UObject* WorldContextObject, FMixerChannelHandle Channel);
+
+		UFUNCTION(BlueprintPure, Category = "SoundClassMixerPlugin|Channels", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static float GetMixerChannelVolume(const UObject* WorldContextObject, FMixerChannelHandle Channel);
+
+		
+	public:
+		/** Runs a multi-point volume envelope (or a baked float curve) on the class as one command. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Envelopes", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void SoundClassRunEnvelope(const UObject* WorldContextObject, USoundClass* TargetClass, const FSoundClassMixerEnvelope& Envelope);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Envelopes", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void SoundSubmixRunEnvelope(const UObject* WorldContextObject, USoundSubmix* TargetSubmix, const FSoundClassMixerEnvelope& Envelope);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Envelopes", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void MixerChannelRunEnvelope(const UObject* WorldContextObject, FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope);
+
+		
+	public:
+		/** Ducks the request's target classes until released; returns the id to pass to ReleaseSoundClassDuck. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Ducking", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static int32 PushSoundClassDuck(const UObject* WorldContextObject, const FSoundClassMixerDuckRequest& Request);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Ducking", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void ReleaseSoundClassDuck(const UObject* WorldContextObject, int32 DuckId);
+
+		/** Ducks the targets by the source submix's envelope; tracked on the audio render thread. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Ducking", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static int32 AddSubmixSidechain(const UObject* WorldContextObject, const FSoundClassMixerSidechainSettings& Settings);
+
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Ducking", meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void RemoveSubmixSidechain(const UObject* WorldContextObject, int32 SidechainId);
+
+		
+	public:
+		/** Fades every SoundClass/SoundSubmix listed in the snapshot, pushed to the audio thread as one batch. */
+		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = SoundClassMixerPlugin, meta=(WorldContext = "WorldContextObject", CallableWithoutWorldContext))
+			static void ApplyMixerSnapshot(const UObject* WorldContextObject, USoundClassMixerSnapshot* Snapshot);
 		
 
 	public:
@@ -163,4 +235,9 @@ class SOUNDCLASSMIXER_API USoundClassMixerBlueprintFunctionLibrary : public UBlu
 
 		UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "SoundClassMixerPlugin|Utils")
 			static float ConvertToDecibels(const float Value);
+
+
+	private:
+		/** The context's game instance mixer; null (and logged) without a world or game instance, callers skip the call. */
+		static USoundClassMixerSubsystem* GetMixerSubsystem(const UObject* WorldContextObject);
 };
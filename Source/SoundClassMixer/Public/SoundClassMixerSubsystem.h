@@ -1,19 +1,149 @@
 ﻿#pragma once
 
 #include "SimpleFader.h"
+#include "SimpleFaderBank.h"
+#include "SoundClassMixerLatencyHistogram.h"
+#include "SoundClassMixerSidechain.h"
 #include "Tickable.h"
+#include "Components/AudioComponent.h"
+#include "Containers/CircularQueue.h"
+#include "Engine/StreamableManager.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
+#include <atomic>
+#include <type_traits>
+
 #include "SoundClassMixerSubsystem.generated.h"
 
 
+class UCurveFloat;
 class USoundClass;
+class USoundMix;
+class FAudioDevice;
+class USoundClassMixerSubmixFaderPreset;
+class USoundClassMixerSnapshot;
 class USoundClassMixerBlueprintFunctionLibrary;
 class FSoundClassMixerCommands;
-enum class EAudioFaderCurve : uint8;
+struct FSoundClassMixerManifest;
+struct FSoundClassMixerSubmixFaderState;
 
 
 DECLARE_LOG_CATEGORY_CLASS(LogSoundClassMixerSubsystem, Display, All);
+DECLARE_STATS_GROUP(TEXT("SoundClassMixer"), STATGROUP_SoundClassMixer, STATCAT_Advanced);
+
+
+enum class ESoundClassMixerCommandType : uint8
+{
+	SetVolume,
+	StartFade,
+	StopFade,
+
+	/** Fades the channel's duck gain, which multiplies the fader volume. */
+	StartDuck,
+
+	/** Runs Envelope on the channel's fader. */
+	StartEnvelope
+};
+
+enum class ESoundClassMixerTargetType : uint8
+{
+	SoundClass,
+	SoundSubmix
+};
+
+/**
+ * Stable reference to a managed SoundClass/SoundSubmix: an index into the subsystem's channel array
+ * plus the generation of that slot. Resolve once with GetSoundClassChannel/GetSoundSubmixChannel;
+ * a handle whose slot was released or reused no longer validates and is ignored.
+ */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FMixerChannelHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SoundClassMixerPlugin|Channels")
+		int32 Index = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SoundClassMixerPlugin|Channels")
+		int32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+/** Mixer command; written by the game thread, drained in one batch on the audio thread. */
+struct FSoundClassMixerCommand
+{
+	/** The targeted asset, of type TargetType. */
+	UObject* Target = nullptr;
+
+	/** Slot the command applies to; unset while Target is still pending, resolved when it registers. */
+	FMixerChannelHandle Channel;
+
+	float Volume   = 1.0f;
+	float Duration = 0.0f;
+
+	ESoundClassMixerCommandType Type       = ESoundClassMixerCommandType::SetVolume;
+	ESoundClassMixerTargetType  TargetType = ESoundClassMixerTargetType::SoundClass;
+	Audio::EFaderCurve          Curve      = Audio::EFaderCurve::Linear;
+
+	bool bIsFadeOut = false;
+
+	/** Submix fader commands mirrored to a render thread fader effect: the FadeId pushed to it, 0 otherwise. */
+	int32 RenderFadeId = 0;
+
+	/** StartEnvelope only; key into the subsystem's CommandEnvelopes, 0 for none. */
+	uint32 EnvelopeId = 0;
+
+	/** FPlatformTime::Cycles64 when pushed to the ring, 0 for commands applied in place. Feeds the latency stat. */
+	uint64 EnqueueCycles = 0;
+};
+
+static_assert(std::is_trivially_copyable<FSoundClassMixerCommand>::value, "Mixer commands are copied through the lock free rings.");
+
+/** Snapshot of the command queue counters, safe to read from any thread. */
+struct FSoundClassMixerCommandQueueStats
+{
+	/** Commands drained by the last batch. */
+	uint32 LastQueueDepth = 0;
+
+	/** Highest batch size seen so far. */
+	uint32 PeakQueueDepth = 0;
+
+	/** Commands that didn't fit in the ring and spilled into the overflow ring. */
+	uint32 OverflowCount = 0;
+
+	/** Commands held on the game thread for a later frame because both rings were full. */
+	uint32 HeldCount = 0;
+
+	/** Commands dropped on the game thread because a later one in the same frame superseded them. */
+	uint32 CoalescedCount = 0;
+
+	/** Time spent applying the last batch. */
+	float LastDrainTimeMs = 0.0f;
+};
+
+
+/** Time from a command being enqueued on the game thread to it being applied on the audio thread. */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerLatencyStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = Latency)
+		float P50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Latency)
+		float P95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Latency)
+		float P99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Latency)
+		float MaxMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Latency)
+		int32 NumSamples = 0;
+};
 
 
 USTRUCT()
@@ -25,9 +155,188 @@ struct FSoundSubSysProperties
 		bool bIsFading = false;
 	
 	FSimpleFader Fader;
+
+	/** Envelope Fader runs, which only holds it by pointer; released once the fader is done with it. Audio thread only. */
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> FaderEnvelope;
+
+	/** Resolved duck gain, 1 when not ducked; the applied volume is Fader * DuckFader * SidechainGain. */
+	FSimpleFader DuckFader;
+
+	/** Product of the sidechains targeting this channel. Audio thread only. */
+	float SidechainGain = 1.0f;
+
+	/** Applied volume; mirrored to the asset unless bDeviceScopedVolumes is set. */
+	float Volume = 1.0f;
+
+	/** Gain last sent to the audio device, negative when unknown. Audio thread only. */
+	float LastAppliedDeviceVolume = -1.0f;
+
+	/**
+	 * Submixes: the submix's render thread fader effect carries Fader's gain, so the device stage only gets
+	 * DuckFader * SidechainGain. Fader holds the fade as started and is not updated meanwhile; it is caught up
+	 * from the effect's published progress when the next command replaces it. Set by the fader commands.
+	 */
+	bool bFaderOnRenderThread = false;
+
+	/** FadeId of the effect fade Fader holds, see bFaderOnRenderThread. */
+	int32 RenderFadeId = 0;
+
+	/** The submix fader effect's published gain and fade progress; set once a fade was pushed to it. */
+	TSharedPtr<const FSoundClassMixerSubmixFaderState, ESPMode::ThreadSafe> RenderFaderState;
+};
+
+/** One managed SoundClass/SoundSubmix. Slots are reused, Generation tells the occupants apart. */
+USTRUCT()
+struct FSoundClassMixerChannel
+{
+	GENERATED_BODY()
+
+	/** Null while the slot is free. */
+	UPROPERTY()
+		UObject* Target = nullptr;
+
+	UPROPERTY()
+		FSoundSubSysProperties Properties;
+
+	ESoundClassMixerTargetType TargetType = ESoundClassMixerTargetType::SoundClass;
+
+	int32 Generation = 0;
+
+	/** In ActiveChannels. Audio thread only. */
+	bool bIsActive = false;
+
+	/** Position in the SoundClass hierarchy, INDEX_NONE for submixes and classes registered since the last rebuild. */
+	int32 HierarchyIndex = INDEX_NONE;
+};
+
+/** SoundClass tree flattened in pre-order, so every subtree is the contiguous range [Index, SubtreeEnd). */
+struct FSoundClassHierarchyNode
+{
+	int32 Channel = INDEX_NONE;
+
+	/** Node of the nearest managed ancestor, always before this one; INDEX_NONE for roots. */
+	int32 Parent = INDEX_NONE;
+
+	int32 SubtreeEnd = INDEX_NONE;
+
+	/** Product of the volumes of the unmanaged ancestors between this node and Parent, sampled at rebuild. */
+	float BaseVolume = 1.0f;
+};
+
+
+/** Lowers a set of SoundClasses while active, see USoundClassMixerSubsystem::PushDuck. */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerDuckRequest
+{
+	GENERATED_BODY()
+
+	/** The class causing the duck, for debugging only. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking)
+		USoundClass* SourceClass = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking)
+		TArray<USoundClass*> TargetClasses;
+
+	/** How far the targets are lowered, in dB. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking, meta = (ClampMin = "0.0"))
+		float AttenuationDb = 6.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking, meta = (ClampMin = "0.0"))
+		float AttackTime = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking, meta = (ClampMin = "0.0"))
+		float ReleaseTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking)
+		int32 Priority = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ducking)
+		EAudioFaderCurve Curve = EAudioFaderCurve::Linear;
+};
+
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerEnvelopeKey
+{
+	GENERATED_BODY()
+
+	/** Seconds from the start of the envelope. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Envelope, meta = (ClampMin = "0.0"))
+		float Time = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Envelope, meta = (ClampMin = "0.0"))
+		float Volume = 1.0f;
+
+	/** Shape of the segment leading into this key. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Envelope)
+		EAudioFaderCurve Curve = EAudioFaderCurve::Linear;
+};
+
+/**
+ * Multi-point volume automation run as a single command, e.g. dip, hold and recover for a stinger.
+ * Starts from the target's current volume; the first key is reached at its Time.
+ */
+USTRUCT(BlueprintType)
+struct SOUNDCLASSMIXER_API FSoundClassMixerEnvelope
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Envelope)
+		TArray<FSoundClassMixerEnvelopeKey> Keys;
+
+	/** Used instead of Keys when set; X is seconds, Y is volume. Baked once per asset on first use. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Envelope)
+		UCurveFloat* Curve = nullptr;
+};
+
+/** A pushed duck request with its targets resolved to channels. Game thread only. */
+struct FSoundClassMixerActiveDuck
+{
+	TArray<FMixerChannelHandle, TInlineAllocator<4>> Targets;
+
+	float Gain        = 1.0f;
+	float AttackTime  = 0.0f;
+	float ReleaseTime = 0.0f;
+	int32 Priority    = 0;
+
+	Audio::EFaderCurve Curve = Audio::EFaderCurve::Linear;
+};
+
+/** The request currently winning a channel. */
+struct FSoundClassMixerResolvedDuck
+{
+	FMixerChannelHandle Channel;
+
+	float Gain        = 1.0f;
+	float AttackTime  = 0.0f;
+	float ReleaseTime = 0.0f;
+	int32 Priority    = 0;
+
+	Audio::EFaderCurve Curve = Audio::EFaderCurve::Linear;
+};
+
+
+/** Envelope cache entry, see USoundClassMixerSubsystem::FindOrBakeEnvelope. */
+struct FSoundClassMixerCachedEnvelope
+{
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> Envelope;
+
+	/** EnvelopeCacheClock when last returned; the oldest entries are evicted first. */
+	uint64 LastUsed = 0;
 };
 
 
+/** A registered sidechain listener and its resolved targets. */
+struct FSoundClassMixerActiveSidechain
+{
+	TSharedPtr<FSoundClassMixerSidechain, ESPMode::ThreadSafe> Listener;
+	TWeakObjectPtr<USoundSubmix> SourceSubmix;
+	TArray<FMixerChannelHandle> Targets;
+};
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSoundClassMixerReady);
+
+
 /**
  * A Simple Sound Mixer Subsystem for USoundClass's.
  */
@@ -50,48 +359,426 @@ public:
 	virtual ETickableTickType GetTickableTickType() const override;
 	virtual bool IsTickableWhenPaused() const override;
 	virtual bool IsAllowedToTick() const override final;
+	virtual bool IsTickable() const override;
 	virtual void Tick(float DeltaTime) override;
 	virtual TStatId GetStatId() const override;
 	// ~FTickableGameObject
 
 	bool IsInitialized() const { return bInitialized; }
 
+	/** True once every gathered SoundClass/SoundSubmix is registered (immediately unless async gathering). */
+	UFUNCTION(BlueprintPure, Category = SoundClassMixerPlugin)
+		bool IsReady() const;
+
+	UFUNCTION(BlueprintPure, Category = SoundClassMixerPlugin)
+		bool IsSoundClassReady(const USoundClass* SoundClassAsset) const;
+
+	UFUNCTION(BlueprintPure, Category = SoundClassMixerPlugin)
+		bool IsSoundSubmixReady(const USoundSubmix* SoundSubmixAsset) const;
+
+	/**
+	 * Volume of the class multiplied by all of its parents' volumes, as last applied by the mixer.
+	 * Cached and updated only for subtrees whose faders moved, cheap enough to poll every frame.
+	 */
+	UFUNCTION(BlueprintPure, Category = SoundClassMixerPlugin)
+		float GetEffectiveSoundClassVolume(const USoundClass* SoundClassAsset) const;
+
+	FSoundClassMixerCommandQueueStats GetCommandQueueStats() const;
+
+	/**
+	 * Percentiles since startup or the last reset; commands applied in place on the audio thread aren't counted.
+	 * Also printed by the SoundClassMixer.Latency.Report console command, cleared by SoundClassMixer.Latency.Reset.
+	 */
+	UFUNCTION(BlueprintPure, Category = "SoundClassMixerPlugin|Debug")
+		FSoundClassMixerLatencyStats GetCommandLatencyStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "SoundClassMixerPlugin|Debug")
+		void ResetCommandLatencyStats();
+
+	/**
+	 * Starts ducking the request's targets; returns an id for ReleaseDuck.
+	 * Overlapping requests are resolved once per update into a single duck gain per SoundClass,
+	 * according to USoundClassMixerSettings::DuckPolicy.
+	 */
+	int32 PushDuck(const FSoundClassMixerDuckRequest& Request);
+
+	/** Stops a duck; its targets return to the next winning request, or unity, over its release time. */
+	void ReleaseDuck(int32 DuckId);
+
+	/**
+	 * Follows the source submix's envelope on the audio render thread and ducks the targets by it.
+	 * The gain is polled by the audio thread update, which keeps ticking while a sidechain is registered.
+	 * Returns an id for RemoveSidechain, or INDEX_NONE when none of the targets is managed by the mixer.
+	 */
+	int32 AddSidechain(const FSoundClassMixerSidechainSettings& Settings);
+	void RemoveSidechain(int32 SidechainId);
+
+	/** Handle for a registered asset; unset when the asset isn't managed (yet). */
+	FMixerChannelHandle GetSoundClassChannel(const USoundClass* SoundClassAsset) const;
+	FMixerChannelHandle GetSoundSubmixChannel(const USoundSubmix* SoundSubmixAsset) const;
+
+	/** False for unset handles and for handles whose slot has since been released. */
+	bool IsChannelValid(FMixerChannelHandle Channel) const;
+
+	/** Channel state for debugging, null for unmanaged assets. Game thread only. */
+	const FSoundSubSysProperties* FindSoundClassProperties(const USoundClass* SoundClassAsset) const;
+	const FSoundSubSysProperties* FindSoundSubmixProperties(const USoundSubmix* SoundSubmixAsset) const;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** Stages of the gather, registration and command paths, for benchmarks timing them one at a time. */
+	void ResetChannelsForTesting();
+	void GatherSoundClassesForTesting() { GatherSoundClasses(); }
+
+	/** The two gather paths synchronously, each followed by the hierarchy rebuild GatherSoundClasses does. */
+	void GatherFromAssetRegistryForTesting();
+	void GatherFromManifestForTesting(const FSoundClassMixerManifest& Manifest);
+
+	/** Registers the classes, then rebuilds the hierarchy once. */
+	void RegisterSoundClassesForTesting(TArrayView<USoundClass* const> SoundClasses);
+
+	void UpdateAudioClassesForTesting() { UpdateAudioClasses(); }
+	void EnqueueCommandsForTesting(TArrayView<const FSoundClassMixerCommand> Commands) { EnqueueCommands(Commands); }
+	void CoalesceCommandForTesting(const FSoundClassMixerCommand& Command) { CoalesceCommand(Command); }
+	void FlushCoalescedCommandsForTesting() { FlushCoalescedCommands(); }
+	void DrainCommandsForTesting();
+	USoundClass* FindSoundClassByNameForTesting(const FString& SoundClassName) const { return FindSoundClassByName(SoundClassName); }
+	static constexpr uint32 GetCommandQueueCapacityForTesting() { return CommandQueueCapacity; }
+#endif
+
 	
 private:
 	void GatherSoundClasses();
+	void GatherFromManifest(const FSoundClassMixerManifest& Manifest);
+	void GatherFromAssetRegistry();
+
+	/** Streams the given assets in batches, each registering as its batch completes. */
+	void RequestAsyncLoad(const TArray<FSoftObjectPath>& AssetPaths);
+	void OnAsyncLoadBatchCompleted(TArray<FSoftObjectPath> Batch);
+	void OnGatherCompleted();
+
+	/** True while the asset is gathered but not yet registered. */
+	bool IsAssetPending(const UObject* Asset) const;
+
+	/** Re-enqueues commands issued before the asset finished loading. */
+	void FlushDeferredCommands(const UObject* Asset);
+
+	/** Adds an asset to its map and to the name index, its channel starting at the asset's current volume. */
+	void RegisterSoundClass(USoundClass* SoundClassAsset);
+	void RegisterSoundSubmix(USoundSubmix* SoundSubmixAsset);
+
+	/**
+	 * Variants starting the channel at InitialVolume, the manifest's cook time volume.
+	 * An asset whose volume an earlier game instance left changed is set back to it.
+	 */
+	void RegisterSoundClass(USoundClass* SoundClassAsset, float InitialVolume);
+	void RegisterSoundSubmix(USoundSubmix* SoundSubmixAsset, float InitialVolume);
+
+	/** Takes a free channel slot (or appends one) for the asset; must hold AudioStateCriticalSection. */
+	int32 AllocateChannel(UObject* Target, ESoundClassMixerTargetType TargetType, float InitialVolume);
+
+	/** Releases every slot and bumps its generation so outstanding handles stop validating. */
+	void ReleaseAllChannels();
+
+	/** Flattens the registered SoundClasses into SoundClassHierarchy and recomputes every effective volume. */
+	void RebuildSoundClassHierarchy();
+
+	/** Recomputes effective volumes for the nodes in [Begin, End); parents must already be up to date. */
+	void PropagateSoundClassVolumes(int32 Begin, int32 End);
+
+	/** Propagates and clears DirtySoundClassNodes; must be called on the audio thread. */
+	void PropagateDirtySoundClassNodes();
+
+	/** Handle based variants; stale handles are logged and ignored. */
+	void SetChannelVolumeInternal(FMixerChannelHandle Channel, float AdjustVolumeLevel);
+	void AdjustChannelVolumeInternal(FMixerChannelHandle Channel, float AdjustVolumeDuration, float AdjustVolumeLevel, EAudioFaderCurve FadeCurve);
+	void StopChannelFadeInternal(FMixerChannelHandle Channel);
+	float GetChannelVolumeInternal(FMixerChannelHandle Channel) const;
+
+	/** Channel volume of a managed asset; the asset's own volume while it isn't registered (yet). */
+	float GetSoundClassVolumeInternal(const USoundClass* SoundClassAsset) const;
+	float GetSoundSubmixVolumeInternal(const USoundSubmix* SoundSubmixAsset) const;
+
 	void SetSoundClassVolumeInternal(const USoundClass* SoundClassAsset, float AdjustVolumeLevel);
 
 	void AdjustSoundClassVolumeInternal(
 		const USoundClass*     SoundClassAsset, float AdjustVolumeDuration, float AdjustVolumeLevel, bool bInIsFadeOut,
 		const EAudioFaderCurve FadeCurve
 	);
-	USoundClass* FindSoundClassByName(const FString& SoundClassName);
+	void StopSoundClassFadeInternal(const USoundClass* SoundClassAsset);
+	USoundClass* FindSoundClassByName(const FString& SoundClassName) const;
+	USoundClass* FindSoundClassByName(FName SoundClassName) const;
 	void         SetSoundSubmixVolumeInternal(const USoundSubmix* SoundSubmixAsset, float AdjustVolumeLevel);
 
 	void AdjustSoundSubmixVolumeInternal(
 		const USoundSubmix* SoundSubmixAsset, float AdjustVolumeDuration, float AdjustVolumeLevel, bool bInIsFadeOut,
 		EAudioFaderCurve    FadeCurve
 	);
-	USoundSubmix* FindSoundSubmixByName(const FString& SoundSubmixName);
+	void          StopSoundSubmixFadeInternal(const USoundSubmix* SoundSubmixAsset);
+	USoundSubmix* FindSoundSubmixByName(const FString& SoundSubmixName) const;
+	USoundSubmix* FindSoundSubmixByName(FName SoundSubmixName) const;
+
+	/**
+	 * Runs the envelope on the target's fader, advanced by the audio thread update like any fade.
+	 * Submixes follow it on the audio thread even with bRenderThreadSubmixFades; the fader effect is parked
+	 * at unity meanwhile.
+	 */
+	void RunEnvelopeInternal(UObject* Target, ESoundClassMixerTargetType TargetType, FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope);
+	void RunChannelEnvelopeInternal(FMixerChannelHandle Channel, const FSoundClassMixerEnvelope& Envelope);
+
+	/** Returns the baked envelope, cached per curve asset and per key set; null when there are no keys. */
+	TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe> FindOrBakeEnvelope(const FSoundClassMixerEnvelope& Envelope);
+
+	/** Drops entries of collected curves, then the least recently used ones above MaxCachedEnvelopes. */
+	void TrimEnvelopeCache();
+
+	/** Queues every entry of the snapshot in one batch; they're applied in the same audio thread update. */
+	void ApplyMixerSnapshotInternal(const USoundClassMixerSnapshot* Snapshot);
+
+	/**
+	 * Pushes a command to the audio thread; applied immediately when already on it.
+	 * Game thread commands are coalesced per target until the next UpdateAudioClasses,
+	 * which submits the survivors to the ring in their original order.
+	 */
+	void EnqueueCommand(const FSoundClassMixerCommand& Command);
+	void EnqueueCommands(TArrayView<const FSoundClassMixerCommand> Commands);
+
+	/** Last-writer-wins against the commands already pending for the same target and fader. */
+	void CoalesceCommand(const FSoundClassMixerCommand& Command);
+
+	/** Submits the surviving coalesced commands. Game thread only. */
+	void FlushCoalescedCommands();
+
+	/**
+	 * Hands commands to the ring, deferring the ones whose asset is still loading. Game thread only.
+	 * Returns how many were consumed; stops early once the ring and the overflow ring are both full.
+	 */
+	int32 SubmitCommands(TArrayView<const FSoundClassMixerCommand> Commands);
+
+	/** Applies every queued command, the ring before the overflow ring; must be called on the audio thread. */
+	void DrainCommands();
 
-	/** Sync fader state from asset defaults; runs on the audio thread. */
-	void InitializeFadersOnAudioThread();
+	/** Drops a command's entry in CommandEnvelopes, for commands that will never be applied. Game thread only. */
+	void ReleaseCommandEnvelope(const FSoundClassMixerCommand& Command);
 
 	/** Must be called on the audio thread. */
-	void ApplySubmixVolume(const USoundSubmix* SoundSubmixAsset, float Volume);
+	void ApplyCommand(const FSoundClassMixerCommand& Command);
+
+	/**
+	 * Render thread fades (bRenderThreadSubmixFades): hands the request to the submix's fader effect.
+	 * Returns the request's FadeId, or 0 when the mode is off or the effect can't be attached. The caller still
+	 * enqueues the command with it as RenderFadeId, so the channel fader holds the fade without updating it.
+	 */
+	int32 PushSubmixFaderSettings(const USoundSubmix* SoundSubmixAsset, float Volume, float Duration, EAudioFaderCurve FadeCurve, bool bStopFade);
+	USoundClassMixerSubmixFaderPreset* GetOrAddSubmixFader(USoundSubmix* SoundSubmixAsset);
+	void RemoveSubmixFaders();
+
+	/** Advances a fader held for its render thread fade to where the effect has got to. Under AudioStateCriticalSection. */
+	static void CatchUpRenderThreadFade(FSoundSubSysProperties& Properties);
+
+	/** Must be called on the audio thread. */
+	void ApplySubmixVolume(const USoundSubmix* SoundSubmixAsset, float DeviceVolume);
+
+	/** Device-scoped mode: sets the class override on this game instance's device. Must be called on the audio thread. */
+	void ApplySoundClassVolume(const USoundClass* SoundClassAsset, float Volume);
+
+	/** Forces the next update to resend the submix's gain, after the device volume was changed elsewhere. */
+	void InvalidateSubmixVolumeCache(const USoundSubmix* SoundSubmixAsset);
+
+	/**
+	 * Follows the world's audio device; when it changes, moves DeviceSoundMix over and resends every channel.
+	 * Must be called on the game thread.
+	 */
+	void SyncAudioDevice();
+
+	/** Device volumes are applied to, resolved through the device manager so it is safe off the game thread. */
+	FAudioDevice* GetMixerAudioDevice() const;
+
+	/** Resolves ActiveDucks into one duck target per channel and enqueues the channels that changed. */
+	void ResolveDucks();
+
+	void RemoveAllSidechains();
+
+	/** Folds the current sidechain gains into their target channels and applies the ones that moved; audio thread only. */
+	void ApplySidechainGains(float SubmixVolumeEpsilon, uint32& NumDeviceCallsSkipped);
 
 	/** Fader update + volume apply; game thread Tick dispatches to the audio thread. */
 	void UpdateAudioClasses();
 
+	/**
+	 * Sets the channel's volume from the given fader volume and its duck and sidechain gains, and sends it to the
+	 * asset or device. Settled channels send exact gains, others only steps above SubmixVolumeEpsilon. Audio thread only.
+	 */
+	void ApplyChannelVolume(FSoundClassMixerChannel& Channel, float FaderVolume, bool bIsSettled, float SubmixVolumeEpsilon, uint32& NumDeviceCallsSkipped);
+
+	/** Queues a channel for the next UpdateAudioClasses; must be called on the audio thread. */
+	void MarkChannelActive(int32 ChannelIndex);
+
 	
 public:
+	/** Broadcast once the gathered assets are all registered. */
+	UPROPERTY(BlueprintAssignable, Category = SoundClassMixerPlugin)
+		FOnSoundClassMixerReady OnReady;
+
+	/**
+	 * Dense channel storage, indexed by FMixerChannelHandle.
+	 * Structural changes happen on the game thread under AudioStateCriticalSection.
+	 */
 	UPROPERTY()
-		TMap<USoundClass*, FSoundSubSysProperties> SoundClassMap;
+		TArray<FSoundClassMixerChannel> Channels;
+
+	/** Asset -> index into Channels. */
+	UPROPERTY()
+		TMap<USoundClass*, int32> SoundClassMap;
 	
 	UPROPERTY()
-		TMap<USoundSubmix*, FSoundSubSysProperties> SoundSubmixMap;
+		TMap<USoundSubmix*, int32> SoundSubmixMap;
+
+	/** Render thread fader effects attached to submixes, see bRenderThreadSubmixFades. */
+	UPROPERTY()
+		TMap<USoundSubmix*, USoundClassMixerSubmixFaderPreset*> SubmixFaderPresets;
+
+	/** Carries the SoundClass overrides in device-scoped mode, see bDeviceScopedVolumes. */
+	UPROPERTY(Transient)
+		USoundMix* DeviceSoundMix = nullptr;
+
+	/** Asset name -> asset, FName compares case-insensitively. Game thread only. */
+	TMap<FName, USoundClass*>  SoundClassNameIndex;
+	TMap<FName, USoundSubmix*> SoundSubmixNameIndex;
 
 	
 private:
 	bool bInitialized = false;
+
+	/** Guards Channels and the asset maps against registration while the audio thread walks them. */
+	mutable FCriticalSection AudioStateCriticalSection;
+
+	/** The world's audio device as of the last SyncAudioDevice, INDEX_NONE when there is none. */
+	std::atomic<uint32> AudioDeviceId { static_cast<uint32>(INDEX_NONE) };
+
+	FStreamableManager StreamableManager;
+	TArray<TSharedPtr<FStreamableHandle>> StreamableHandles;
+
+	/** Gathered assets that are still streaming in. Game thread only. */
+	TSet<FSoftObjectPath> PendingAssetPaths;
+
+	/** Manifest volumes for the pending assets, empty when gathered from the asset registry. Game thread only. */
+	TMap<FSoftObjectPath, float> PendingManifestVolumes;
+
+	/** Commands targeting pending assets. Game thread only. */
+	TArray<FSoundClassMixerCommand> DeferredCommands;
+
+	/** Channels of a snapshot's entries, parallel to its SoundClasses/SoundSubmixes; unset while pending. */
+	struct FResolvedMixerSnapshot
+	{
+		TArray<FMixerChannelHandle> SoundClassChannels;
+		TArray<FMixerChannelHandle> SoundSubmixChannels;
+	};
+
+	/** Per applied snapshot; an entry is looked up again only once its handle stops validating. Game thread only. */
+	TMap<TWeakObjectPtr<const USoundClassMixerSnapshot>, FResolvedMixerSnapshot> ResolvedSnapshots;
+
+	/**
+	 * Indices into CoalescedCommands of the pending commands for one (target, fader).
+	 * A pending set is kept under a later fade since the fade starts from the value it sets.
+	 */
+	struct FCoalescedCommandSlots
+	{
+		int32 SetIndex  = INDEX_NONE;
+		int32 FadeIndex = INDEX_NONE;
+	};
+
+	/** This frame's game thread commands; superseded entries have a null Target. Game thread only. */
+	TArray<FSoundClassMixerCommand> CoalescedCommands;
+	TMap<TPair<const UObject*, bool>, FCoalescedCommandSlots> CoalescedCommandSlots;
+	int32 NumCoalescedThisFrame = 0;
+
+	/** Pushed duck requests by id. Game thread only. */
+	TMap<int32, FSoundClassMixerActiveDuck> ActiveDucks;
+
+	/** Winning request per channel index as of the last ResolveDucks. Game thread only. */
+	TMap<int32, FSoundClassMixerResolvedDuck> ResolvedDucks;
+
+	int32 LastDuckId = 0;
+	bool bDucksDirty = false;
+
+	/** Changed on the game thread under AudioStateCriticalSection, read by the audio thread. */
+	TMap<int32, FSoundClassMixerActiveSidechain> Sidechains;
+
+	int32 LastSidechainId = 0;
+
+	/** Channels with a sidechain gain other than 1, and per update scratch. Audio thread only. */
+	TArray<int32> SidechainChannels;
+	TMap<int32, float> SidechainGainScratch;
+
+	/**
+	 * Baked envelopes per curve asset and per key hash. Commands and channels hold their own references,
+	 * so an evicted envelope lives on until the last fader running it is done. Game thread only.
+	 */
+	TMap<TWeakObjectPtr<UCurveFloat>, FSoundClassMixerCachedEnvelope> CurveEnvelopes;
+	TMap<uint32, FSoundClassMixerCachedEnvelope> KeyEnvelopes;
+	uint64 EnvelopeCacheClock = 0;
+
+	static constexpr int32 MaxCachedEnvelopes = 64;
+
+	static constexpr float CurveEnvelopeSampleInterval = 1.0f / 100.0f;
+
+	/** Released slots in Channels, reused before appending. */
+	TArray<int32> FreeChannels;
+
+	int32 LastSubmixFadeId = 0;
+
+	/** Fixed capacity SPSC ring: game thread produces, audio thread consumes. */
+	static constexpr uint32 CommandQueueCapacity = 1024;
+	TCircularQueue<FSoundClassMixerCommand> CommandQueue { CommandQueueCapacity };
+
+	/** Preallocated spill for bursts past CommandQueueCapacity; used until empty again so commands stay in order. */
+	static constexpr uint32 OverflowQueueCapacity = 2 * CommandQueueCapacity;
+	TCircularQueue<FSoundClassMixerCommand> OverflowQueue { OverflowQueueCapacity };
+
+	/** Baked envelopes of the StartEnvelope commands in flight, by EnvelopeId. Guarded by AudioStateCriticalSection. */
+	TMap<uint32, TSharedPtr<const FSimpleFaderEnvelope, ESPMode::ThreadSafe>> CommandEnvelopes;
+	uint32 LastCommandEnvelopeId = 0;
+
+	std::atomic<uint32> CommandQueueLastDepth { 0 };
+	std::atomic<uint32> CommandQueuePeakDepth { 0 };
+	std::atomic<uint32> CommandQueueOverflowCount { 0 };
+	std::atomic<uint32> CommandQueueHeldCount { 0 };
+	std::atomic<uint32> CommandQueueCoalescedCount { 0 };
+	std::atomic<float>  CommandQueueLastDrainTimeMs { 0.0f };
+
+	/**
+	 * Whether there is queued or fading work on the audio thread side, gates IsTickable.
+	 * Raised by the game thread after enqueueing and by the audio thread when marking entries active,
+	 * cleared by the audio thread once the ring and the active sets are empty.
+	 * Game thread work (CoalescedCommands) is checked separately since an in-flight update may clear this.
+	 */
+	std::atomic<bool> bHasPendingWork { false };
+
+	/** GFrameCounter of the last Tick; the frames in between were skipped as idle. Game thread only. */
+	uint64 LastTickFrame = 0;
+
+	/** Time not yet consumed by FaderFixedTimeStep steps. Audio thread only. */
+	float FaderTimeAccumulator = 0.0f;
+
+	/** Channels whose fader is fading or whose output changed. Audio thread only. */
+	TArray<int32> ActiveChannels;
+
+	/**
+	 * Running single segment channel fades keyed by channel index, advanced together each update.
+	 * Audio thread, or game thread under AudioStateCriticalSection.
+	 */
+	FSimpleFaderBank FaderBank;
+
+	/** Rebuilt on the game thread under AudioStateCriticalSection, updated by the audio thread. */
+	TArray<FSoundClassHierarchyNode> SoundClassHierarchy;
+	TArray<float> EffectiveSoundClassVolumes;
+
+	/** Highest game thread -> audio thread command latency since the last update. Audio thread only. */
+	float MaxCommandLatencyMs = 0.0f;
+
+	/** Written by the audio thread, read from anywhere. */
+	FSoundClassMixerLatencyHistogram CommandLatencyHistogram;
+
+	/** Hierarchy nodes whose class volume changed this update. Audio thread only. */
+	TArray<int32> DirtySoundClassNodes;
 };
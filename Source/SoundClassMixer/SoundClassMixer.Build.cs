@@ -36,6 +36,7 @@ public class SoundClassMixer : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
+				"AudioMixer",
 			}
 		);
 		
@@ -43,5 +44,13 @@ public class SoundClassMixer : ModuleRules
 		{
 			PrivateDependencyModuleNames.Add("UnrealEd");
 		}
+
+		// Cooked builds read the manifest written by the SoundClassMixerManifest commandlet (see
+		// FSoundClassMixerManifest::GetDefaultFilename). It isn't an asset, so the cook would leave it out.
+		// Wildcard so builds without a manifest still package; GatherSoundClasses warns and scans instead.
+		if (Target.ProjectFile != null)
+		{
+			RuntimeDependencies.Add("$(ProjectDir)/Content/SoundClassMixer/*.bin", StagedFileType.UFS);
+		}
 	}
 }
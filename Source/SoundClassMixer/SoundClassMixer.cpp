@@ -1,5 +1,7 @@
 #include "SoundClassMixer.h"
 
+#include "SoundBaseWrapperCache.h"
+
 #define LOCTEXT_NAMESPACE "SoundClassMixerModule"
 
 void FSoundClassMixerModule::StartupModule()
@@ -9,6 +11,8 @@ void FSoundClassMixerModule::StartupModule()
 
 void FSoundClassMixerModule::ShutdownModule()
 {
+	FSoundBaseWrapperCache::Shutdown();
+
 	UE_LOG(LogSoundClassMixerModule, Verbose, TEXT("SoundClassMixerModule Unloaded."));
 }
 